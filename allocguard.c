@@ -0,0 +1,109 @@
+#include "allocguard.h"
+
+#include <errno.h>
+#include <malloc.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// glibc's own allocator entry points, which the wrappers below forward to
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *pointer, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void *__libc_valloc(size_t size);
+extern void *__libc_pvalloc(size_t size);
+
+static __thread bool guardArmed = false;
+
+void AllocGuardArm(void)
+{
+    guardArmed = true;
+}
+
+void AllocGuardDisarm(void)
+{
+    guardArmed = false;
+}
+
+static void Trip(const char *function, size_t size)
+{
+    guardArmed = false;
+
+    // No printf here, it may allocate itself
+    char message[96] = "AllocGuard: ";
+    strcat(message, function);
+    strcat(message, " of ");
+    char digits[24];
+    int length = 0;
+    do {
+        digits[length++] = (char)('0' + size % 10);
+        size /= 10;
+    } while (size > 0);
+    size_t end = strlen(message);
+    while (length > 0) message[end++] = digits[--length];
+    message[end] = '\0';
+    strcat(message, " bytes in the match loop\n");
+
+    if (write(STDERR_FILENO, message, strlen(message)) < 0) {
+        // Nowhere left to report it, abort anyway
+    }
+    abort();
+}
+
+void *malloc(size_t size)
+{
+    if (guardArmed) Trip("malloc", size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    if (guardArmed) Trip("calloc", count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size)
+{
+    if (guardArmed) Trip("realloc", size);
+    return __libc_realloc(pointer, size);
+}
+
+// The aligned entry points don't go through malloc in glibc, so they need
+// their own checks
+
+void *memalign(size_t alignment, size_t size)
+{
+    if (guardArmed) Trip("memalign", size);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    if (guardArmed) Trip("aligned_alloc", size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **pointer, size_t alignment, size_t size)
+{
+    if (guardArmed) Trip("posix_memalign", size);
+    // Same rules glibc applies: a power of two that is a multiple of sizeof(void *)
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0) return EINVAL;
+    void *memory = __libc_memalign(alignment, size);
+    if (memory == NULL) return ENOMEM;
+    *pointer = memory;
+    return 0;
+}
+
+void *valloc(size_t size)
+{
+    if (guardArmed) Trip("valloc", size);
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size)
+{
+    if (guardArmed) Trip("pvalloc", size);
+    return __libc_pvalloc(size);
+}
@@ -0,0 +1,19 @@
+#ifndef ALLOCGUARD_H
+#define ALLOCGUARD_H
+
+// Debug check that the match loop never touches the heap. Build with
+// -DPONGIVERSE_ALLOC_GUARD and allocguard.c (glibc only): while armed, any
+// malloc/calloc/realloc or aligned allocation (posix_memalign, aligned_alloc,
+// memalign, valloc, pvalloc) on the arming thread prints its size and aborts,
+// so a debugger lands right on the offending call. Other threads (music, hot
+// reload, pager) are never checked.
+
+#ifdef PONGIVERSE_ALLOC_GUARD
+void AllocGuardArm(void);
+void AllocGuardDisarm(void);
+#else
+#define AllocGuardArm() ((void)0)
+#define AllocGuardDisarm() ((void)0)
+#endif
+
+#endif
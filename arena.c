@@ -0,0 +1,121 @@
+#include "arena.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+bool ArenaInit(Arena *arena, size_t capacity)
+{
+    arena->base = malloc(capacity);
+    arena->capacity = (arena->base != NULL) ? capacity : 0;
+    arena->used = 0;
+    arena->highWater = 0;
+    return arena->base != NULL;
+}
+
+void ArenaFree(Arena *arena)
+{
+    free(arena->base);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+}
+
+void ArenaReset(Arena *arena)
+{
+    if (arena->used > arena->highWater) arena->highWater = arena->used;
+    arena->used = 0;
+}
+
+void *ArenaAlloc(Arena *arena, size_t size)
+{
+    size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (start > arena->capacity || size > arena->capacity - start) return NULL;
+
+    arena->used = start + size;
+    if (arena->used > arena->highWater) arena->highWater = arena->used;
+    return arena->base + start;
+}
+
+const char *ArenaPrintf(Arena *arena, const char *format, ...)
+{
+    // Format straight into the free space, one pass instead of measuring first
+    size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (start >= arena->capacity) return "";
+    char *text = (char *)arena->base + start;
+    size_t room = arena->capacity - start;
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, room, format, args);
+    va_end(args);
+    if (length < 0 || (size_t)length >= room) return "";
+
+    arena->used = start + (size_t)length + 1;
+    if (arena->used > arena->highWater) arena->highWater = arena->used;
+    return text;
+}
+
+bool PoolInit(Pool *pool, size_t itemSize, int capacity)
+{
+    // Keep every item aligned like the arena does
+    pool->itemSize = (itemSize + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    pool->items = malloc(pool->itemSize * capacity);
+    pool->freeList = malloc(sizeof(int) * capacity);
+    pool->inUse = calloc(capacity, sizeof(bool));
+    if (pool->items == NULL || pool->freeList == NULL || pool->inUse == NULL) {
+        PoolFree(pool);
+        return false;
+    }
+
+    pool->capacity = capacity;
+    // Hand out low indices first so live items stay packed together
+    for (int i = 0; i < capacity; i++) pool->freeList[i] = capacity - 1 - i;
+    pool->freeCount = capacity;
+    pool->highWater = 0;
+    return true;
+}
+
+void PoolFree(Pool *pool)
+{
+    free(pool->items);
+    free(pool->freeList);
+    free(pool->inUse);
+    pool->items = NULL;
+    pool->freeList = NULL;
+    pool->inUse = NULL;
+    pool->capacity = 0;
+    pool->freeCount = 0;
+}
+
+void *PoolAcquire(Pool *pool)
+{
+    if (pool->freeCount == 0) return NULL;
+
+    int index = pool->freeList[--pool->freeCount];
+    pool->inUse[index] = true;
+    if (PoolInUse(pool) > pool->highWater) pool->highWater = PoolInUse(pool);
+    return pool->items + (size_t)index * pool->itemSize;
+}
+
+bool PoolRelease(Pool *pool, void *item)
+{
+    // Compare as integers, pointer arithmetic outside the block is undefined
+    uintptr_t address = (uintptr_t)item;
+    uintptr_t first = (uintptr_t)pool->items;
+    if (item == NULL || address < first) return false;
+    size_t offset = (size_t)(address - first);
+    if (offset % pool->itemSize != 0 || offset / pool->itemSize >= (size_t)pool->capacity) return false;
+
+    int index = (int)(offset / pool->itemSize);
+    if (!pool->inUse[index]) return false; // released twice
+    pool->inUse[index] = false;
+    pool->freeList[pool->freeCount++] = index;
+    return true;
+}
+
+int PoolInUse(const Pool *pool)
+{
+    return pool->capacity - pool->freeCount;
+}
@@ -0,0 +1,47 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Allocation without malloc in the frame loop. Both are sized once at startup:
+// an Arena hands out scratch memory that is thrown away every frame (HUD
+// strings and the like), a Pool recycles fixed-size objects that live across
+// frames (balls, particles, events). Each keeps a high-water mark so the sizes
+// can be tuned from real play.
+
+#define FRAME_ARENA_SIZE (16 * 1024)
+#define ARENA_ALIGNMENT 16
+
+typedef struct Arena {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t highWater; // most ever used in one frame
+} Arena;
+
+bool ArenaInit(Arena *arena, size_t capacity);
+void ArenaFree(Arena *arena);
+void ArenaReset(Arena *arena); // start of every frame
+void *ArenaAlloc(Arena *arena, size_t size); // NULL when the arena is full
+const char *ArenaPrintf(Arena *arena, const char *format, ...); // read-only, "" when the arena is full
+
+typedef struct Pool {
+    unsigned char *items;
+    size_t itemSize;
+    int capacity;
+    int *freeList;    // indices of free items, used as a stack
+    bool *inUse;      // per item, catches double releases
+    int freeCount;
+    int highWater;    // most items ever in use at once
+} Pool;
+
+bool PoolInit(Pool *pool, size_t itemSize, int capacity);
+void PoolFree(Pool *pool);
+void *PoolAcquire(Pool *pool); // NULL when every item is in use
+// Returns false and leaves the pool alone for a pointer that isn't an item of
+// this pool or is already free, instead of corrupting the free list
+bool PoolRelease(Pool *pool, void *item);
+int PoolInUse(const Pool *pool);
+
+#endif
@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "arena.h"
+#include "pongenv.h"
+#include "pongleague.h"
+#include "pongsim.h"
+#ifdef PONGIVERSE_BENCH_ASSETS
+#include <raylib.h>
+#endif
+
+// Physics and frame-cost benchmarks. Every result is a time (lower is better)
+// and is written as one flat JSON object. With --baseline the results are
+// compared against a committed run and the exit code is 1 if anything got
+// slower than its threshold allows. Cases the baseline has no value for are
+// listed as unrecorded and don't fail the run.
+//
+// Usage: pongiverse_bench [--out results.json] [--baseline baseline.json] [--threshold 0.25]
+// --threshold replaces every case's own threshold.
+
+#define MAX_RESULTS 16
+#define BENCH_ROUNDS 9 // every case runs once per round and keeps its median
+
+typedef struct BenchResult {
+    const char *name;
+    double value;
+    double threshold; // allowed slowdown against the baseline, 0.25 = 25%
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static volatile unsigned long long sink; // keeps the compiler from dropping the work
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static unsigned int NextInput(unsigned int *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 16;
+}
+
+static void AddResult(const char *name, double value, double threshold)
+{
+    results[resultCount].name = name;
+    results[resultCount].value = value;
+    results[resultCount].threshold = threshold;
+    resultCount++;
+    printf("%-28s %12.2f\n", name, value);
+}
+
+//------------------------------------------------------------------------------------
+// Cases, each returns the time of one run
+//------------------------------------------------------------------------------------
+#define SIM_TICKS 2000000
+
+// Single-ball physics with random paddle input, ns per tick
+static double BenchSimTick(void)
+{
+    PongSim sim;
+    PongSimInit(&sim, PADDLE_WIDTH, PADDLE_HEIGHT);
+    unsigned int rng = 1;
+
+    double start = Now();
+    for (int i = 0; i < SIM_TICKS; i++) {
+        unsigned int input = NextInput(&rng);
+        if (PongSimStep(&sim, input & 0x0f, (input >> 4) & 0x0f) & PONG_EVENT_GAME_END) PongSimRestart(&sim);
+    }
+    double elapsed = Now() - start;
+
+    sink += PongSimHash(&sim);
+    return elapsed * 1e9 / SIM_TICKS;
+}
+
+#define RALLY_TICKS 6000000 // a rally tick is cheap, so run more of them for a similar run time
+
+// Two paddles that never miss keep the ball on the paddle collision path, ns per tick
+static double BenchCollisionRally(void)
+{
+    PongAIConfig wall = { "Wall", 0, 0, 100, false };
+    PongSim sim;
+    PongSimInit(&sim, PADDLE_WIDTH, PADDLE_HEIGHT);
+    unsigned int rng1 = 1, rng2 = 2;
+    int hits = 0;
+
+    double start = Now();
+    for (int i = 0; i < RALLY_TICKS; i++) {
+        int events = PongSimStep(&sim, PongAIInput(&wall, &sim, 1, &rng1), PongAIInput(&wall, &sim, 2, &rng2));
+        if (events & PONG_EVENT_PADDLE_HIT) hits++;
+        if (events & PONG_EVENT_GAME_END) PongSimRestart(&sim);
+    }
+    double elapsed = Now() - start;
+
+    sink += hits;
+    return elapsed * 1e9 / RALLY_TICKS;
+}
+
+#define ENV_COUNT 4096
+#define ENV_STEPS 500
+
+// Many balls at once through the batched environment, ns per environment step
+static double BenchEnvStep(void)
+{
+    static unsigned char actions[ENV_COUNT * 2];
+    PongEnv *env = PongEnvCreate(ENV_COUNT, 1);
+    if (env == NULL) return 0.0;
+    unsigned int rng = 1;
+
+    double start = Now();
+    for (int step = 0; step < ENV_STEPS; step++) {
+        for (int i = 0; i < ENV_COUNT * 2; i++) actions[i] = NextInput(&rng) & 0x0f;
+        PongEnvStep(env, actions);
+    }
+    double elapsed = Now() - start;
+
+    sink += PongEnvDones(env)[0];
+    PongEnvDestroy(env);
+    return elapsed * 1e9 / ((double)ENV_COUNT * ENV_STEPS);
+}
+
+#define HUD_FRAMES 4000000 // long enough that a scheduler hiccup is a small part of a run
+
+// Formatting the score text the way the game does every frame, ns per frame
+static double BenchHudText(void)
+{
+    Arena frameArena;
+    if (!ArenaInit(&frameArena, FRAME_ARENA_SIZE)) return 0.0;
+
+    double start = Now();
+    for (int i = 0; i < HUD_FRAMES; i++) {
+        ArenaReset(&frameArena);
+        const char *scoreText1 = ArenaPrintf(&frameArena, "%d", i % WINNING_SCORE);
+        const char *scoreText2 = ArenaPrintf(&frameArena, "%d", (i / 7) % WINNING_SCORE);
+        sink += scoreText1[0] + scoreText2[0];
+    }
+    double elapsed = Now() - start;
+
+    ArenaFree(&frameArena);
+    return elapsed * 1e9 / HUD_FRAMES;
+}
+
+static const char *images[] = {
+    "homescreen.png", "instructions1.png", "instructions2.png", "instructions3.png",
+    "instructions4.png", "instructions5.png", "Tennispaddle.png", "background.png",
+    "table_tennis_background.png", "table_tennis_paddle.png", "table_tennis_ball.png",
+    "air_hockey_background.png", "air_hockey_paddle.png", "air_hockey_ball.png"
+};
+static const char *sounds[] = {
+    "collision.ogg", "table_tennis_collision.ogg", "air_hockey_collision.ogg",
+    "gameend.ogg", "goal_sound.ogg"
+};
+#define IMAGE_COUNT (int)(sizeof(images) / sizeof(images[0]))
+#define SOUND_COUNT (int)(sizeof(sounds) / sizeof(sounds[0]))
+
+static void ReadWholeFile(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = (size > 0) ? malloc(size) : NULL;
+    if (data != NULL && fread(data, 1, size, file) == (size_t)size) sink += data[size - 1];
+    free(data);
+    fclose(file);
+}
+
+// File side of loading every asset, built without raylib too so bigger or
+// more assets show up in every baseline, ms
+static double BenchAssetRead(void)
+{
+    double start = Now();
+    for (int i = 0; i < IMAGE_COUNT; i++) ReadWholeFile(images[i]);
+    for (int i = 0; i < SOUND_COUNT; i++) ReadWholeFile(sounds[i]);
+    return (Now() - start) * 1e3;
+}
+
+#ifdef PONGIVERSE_BENCH_ASSETS
+// CPU side of loading every asset (decode only, no window or audio device), ms
+static double BenchAssetLoad(void)
+{
+    double start = Now();
+    for (int i = 0; i < IMAGE_COUNT; i++) {
+        Image image = LoadImage(images[i]);
+        sink += image.width;
+        UnloadImage(image);
+    }
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        Wave wave = LoadWave(sounds[i]);
+        sink += wave.frameCount;
+        UnloadWave(wave);
+    }
+    return (Now() - start) * 1e3;
+}
+#endif
+
+typedef struct BenchCase {
+    const char *name;
+    double (*run)(void);
+    double threshold;
+} BenchCase;
+
+// Printf and file timings swing more than pure physics, so they get more room
+static const BenchCase cases[] = {
+    { "sim_tick_ns", BenchSimTick, 0.25 },
+    { "collision_rally_tick_ns", BenchCollisionRally, 0.25 },
+    { "env_step_ns", BenchEnvStep, 0.25 },
+    { "hud_text_ns", BenchHudText, 0.40 },
+    { "asset_read_ms", BenchAssetRead, 0.50 },
+#ifdef PONGIVERSE_BENCH_ASSETS
+    { "asset_load_ms", BenchAssetLoad, 0.50 },
+#endif
+};
+#define CASE_COUNT (int)(sizeof(cases) / sizeof(cases[0]))
+
+static int CompareDouble(const void *a, const void *b)
+{
+    double da = *(const double *)a;
+    double db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+// Cases take turns round by round, so a slow stretch of the machine (another
+// process, frequency scaling) lands on one round of every case rather than on
+// every run of one case, and the median throws it away
+static void RunAll(void)
+{
+    static double samples[MAX_RESULTS][BENCH_ROUNDS];
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < CASE_COUNT; i++) samples[i][round] = cases[i].run();
+    }
+    for (int i = 0; i < CASE_COUNT; i++) {
+        qsort(samples[i], BENCH_ROUNDS, sizeof(double), CompareDouble);
+        AddResult(cases[i].name, samples[i][BENCH_ROUNDS / 2], cases[i].threshold);
+    }
+}
+
+//------------------------------------------------------------------------------------
+// JSON in and out
+//------------------------------------------------------------------------------------
+static bool WriteResults(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "{\n");
+#ifdef PONGIVERSE_FIXED_POINT
+    fprintf(file, "  \"fixed_point\": 1,\n");
+#else
+    fprintf(file, "  \"fixed_point\": 0,\n");
+#endif
+    for (int i = 0; i < resultCount; i++) {
+        fprintf(file, "  \"%s\": %.2f%s\n", results[i].name, results[i].value, (i + 1 < resultCount) ? "," : "");
+    }
+    fprintf(file, "}\n");
+
+    fclose(file);
+    return true;
+}
+
+// Finds "name": value in a flat JSON object like the ones WriteResults makes
+static bool ReadBaselineValue(const char *json, const char *name, double *value)
+{
+    char key[64];
+    snprintf(key, sizeof(key), "\"%s\"", name);
+    const char *found = strstr(json, key);
+    if (found == NULL) return false;
+    found = strchr(found + strlen(key), ':');
+    return found != NULL && sscanf(found + 1, "%lf", value) == 1;
+}
+
+// Returns the number of results slower than baseline * (1 + threshold)
+static int CompareBaseline(const char *path, double threshold)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("Can't read baseline %s\n", path);
+        return 1;
+    }
+    char json[4096];
+    size_t length = fread(json, 1, sizeof(json) - 1, file);
+    json[length] = '\0';
+    fclose(file);
+
+    int regressions = 0;
+    printf("\n%-28s %12s %12s %8s %8s\n", "vs baseline", "baseline", "now", "change", "allowed");
+    for (int i = 0; i < resultCount; i++) {
+        double baseline;
+        if (!ReadBaselineValue(json, results[i].name, &baseline) || baseline <= 0.0) {
+            printf("%-28s %12s %12.2f  unrecorded\n", results[i].name, "-", results[i].value);
+            continue;
+        }
+        double allowed = (threshold >= 0.0) ? threshold : results[i].threshold;
+        double change = results[i].value / baseline - 1.0;
+        bool regressed = change > allowed;
+        if (regressed) regressions++;
+        printf("%-28s %12.2f %12.2f %+7.1f%% %7.0f%%%s\n", results[i].name, baseline, results[i].value, change * 100.0,
+               allowed * 100.0, regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
+
+int main(int argc, char **argv)
+{
+    const char *outPath = "bench_results.json";
+    const char *baselinePath = NULL;
+    double threshold = -1.0; // each case's own
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) outPath = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+        else {
+            printf("Usage: %s [--out results.json] [--baseline baseline.json] [--threshold 0.25]\n", argv[0]);
+            return 2;
+        }
+    }
+
+#ifdef PONGIVERSE_BENCH_ASSETS
+    SetTraceLogLevel(LOG_WARNING); // raylib logs every file it loads
+#endif
+    RunAll();
+
+    if (!WriteResults(outPath)) printf("Can't write %s\n", outPath);
+
+    if (baselinePath != NULL) {
+        int regressions = CompareBaseline(baselinePath, threshold);
+        if (regressions > 0) {
+            printf("\n%d result(s) slower than allowed\n", regressions);
+            return 1;
+        }
+    }
+    return 0;
+}
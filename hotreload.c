@@ -0,0 +1,249 @@
+#include "hotreload.h"
+
+#include <stdio.h>
+#include <string.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+bool LoadTuning(const char *path, PongTuning *tuning)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return false;
+
+    char line[128];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char name[32];
+        float value;
+        if (line[0] == '#' || sscanf(line, "%31s %f", name, &value) != 2) continue; // comments and blank lines
+
+        // Ignore values that would stop the game from playing (NaN fails every
+        // comparison) and clamp big ones before converting, so the casts stay in range
+        if (strcmp(name, "paddle_speed") == 0 && value >= 1) {
+            tuning->paddleSpeed = (value > PONG_MAX_PADDLE_SPEED) ? PONG_MAX_PADDLE_SPEED : (int)value;
+        }
+        else if (strcmp(name, "ball_speed") == 0 && value >= 1) {
+            tuning->ballSpeed = (value > PONG_MAX_BALL_SPEED) ? PONG_MAX_BALL_SPEED : (int)value;
+        }
+        // Seconds become whole ticks here, once, so the sim itself never sees a float
+        else if (strcmp(name, "score_delay") == 0 && value >= 0) {
+            float ticks = value * PONG_TICK_RATE + 0.5f;
+            tuning->scoreDelayTicks = (ticks > PONG_MAX_SCORE_DELAY_TICKS) ? PONG_MAX_SCORE_DELAY_TICKS : (int)ticks;
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+void HotReloadInit(HotReload *reload)
+{
+    memset(reload, 0, sizeof(*reload));
+    reload->watchFd = -1;
+    pthread_mutex_init(&reload->lock, NULL);
+}
+
+static WatchedFile *AddWatch(HotReload *reload, const char *path, WatchKind kind)
+{
+    if (reload->fileCount >= HOTRELOAD_MAX_FILES) return NULL;
+
+    WatchedFile *file = &reload->files[reload->fileCount++];
+    memset(file, 0, sizeof(*file));
+    snprintf(file->path, sizeof(file->path), "%s", path);
+    file->kind = kind;
+    return file;
+}
+
+void HotReloadWatchTexture(HotReload *reload, const char *path, Texture2D *texture)
+{
+    WatchedFile *file = AddWatch(reload, path, WATCH_TEXTURE);
+    if (file != NULL) file->texture = texture;
+}
+
+void HotReloadWatchSound(HotReload *reload, const char *path, Sound *sound)
+{
+    WatchedFile *file = AddWatch(reload, path, WATCH_SOUND);
+    if (file != NULL) file->sound = sound;
+}
+
+void HotReloadWatchPage(HotReload *reload, const char *path, ImagePager *pager, int page)
+{
+    WatchedFile *file = AddWatch(reload, path, WATCH_PAGE);
+    if (file != NULL) {
+        file->pager = pager;
+        file->page = page;
+    }
+}
+
+void HotReloadWatchTuning(HotReload *reload, const char *path)
+{
+    AddWatch(reload, path, WATCH_TUNING);
+}
+
+// Decodes a changed file on the watcher thread; only the GPU upload and the
+// swap are left for the main thread
+static void DecodeFile(HotReload *reload, WatchedFile *file)
+{
+    Image image = { 0 };
+    Wave wave = { 0 };
+    PongTuning tuning = PongSimDefaultTuning();
+
+    switch (file->kind)
+    {
+        case WATCH_TEXTURE:
+            image = LoadImage(file->path);
+            if (image.data == NULL) return; // half-written file, the next write event retries
+            break;
+        case WATCH_SOUND:
+            wave = LoadWave(file->path);
+            if (wave.data == NULL) return;
+            break;
+        case WATCH_PAGE:
+            break; // nothing to decode here, the pager reloads it if it's wanted
+        case WATCH_TUNING:
+            if (!LoadTuning(file->path, &tuning)) return;
+            break;
+    }
+
+    pthread_mutex_lock(&reload->lock);
+    // A second save before the main thread got to the first one replaces it
+    if (file->pending) {
+        if (file->kind == WATCH_TEXTURE) UnloadImage(file->image);
+        if (file->kind == WATCH_SOUND) UnloadWave(file->wave);
+    }
+    file->image = image;
+    file->wave = wave;
+    file->tuning = tuning;
+    file->pending = true;
+    pthread_mutex_unlock(&reload->lock);
+}
+
+#ifdef __linux__
+static bool IsRunning(HotReload *reload)
+{
+    pthread_mutex_lock(&reload->lock);
+    bool running = reload->running;
+    pthread_mutex_unlock(&reload->lock);
+    return running;
+}
+
+static void *WatchThread(void *arg)
+{
+    HotReload *reload = arg;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (IsRunning(reload)) {
+        // Wake up now and then to notice HotReloadStop
+        struct pollfd pollFd = { reload->watchFd, POLLIN, 0 };
+        if (poll(&pollFd, 1, 200) <= 0) continue;
+
+        ssize_t length = read(reload->watchFd, buffer, sizeof(buffer));
+        for (char *at = buffer; length > 0 && at < buffer + length; ) {
+            const struct inotify_event *event = (const struct inotify_event *)at;
+            at += sizeof(struct inotify_event) + event->len;
+            if (event->len == 0) continue;
+
+            for (int i = 0; i < reload->fileCount; i++) {
+                if (strcmp(reload->files[i].path, event->name) == 0) DecodeFile(reload, &reload->files[i]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+bool HotReloadStart(HotReload *reload)
+{
+    reload->watchFd = inotify_init1(IN_NONBLOCK);
+    if (reload->watchFd < 0) return false;
+
+    // Editors either write in place or save a new file and rename it over the old one
+    if (inotify_add_watch(reload->watchFd, ".", IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(reload->watchFd);
+        reload->watchFd = -1;
+        return false;
+    }
+
+    reload->running = true;
+    if (pthread_create(&reload->thread, NULL, WatchThread, reload) != 0) {
+        reload->running = false;
+        close(reload->watchFd);
+        reload->watchFd = -1;
+        return false;
+    }
+    return true;
+}
+
+void HotReloadStop(HotReload *reload)
+{
+    if (reload->running) {
+        pthread_mutex_lock(&reload->lock);
+        reload->running = false;
+        pthread_mutex_unlock(&reload->lock);
+        pthread_join(reload->thread, NULL);
+    }
+    if (reload->watchFd >= 0) {
+        close(reload->watchFd);
+        reload->watchFd = -1;
+    }
+
+    // Drop decodes that never got applied
+    for (int i = 0; i < reload->fileCount; i++) {
+        WatchedFile *file = &reload->files[i];
+        if (!file->pending) continue;
+        if (file->kind == WATCH_TEXTURE) UnloadImage(file->image);
+        if (file->kind == WATCH_SOUND) UnloadWave(file->wave);
+        file->pending = false;
+    }
+    pthread_mutex_destroy(&reload->lock);
+}
+#else
+bool HotReloadStart(HotReload *reload)
+{
+    (void)reload;
+    return false;
+}
+
+void HotReloadStop(HotReload *reload)
+{
+    pthread_mutex_destroy(&reload->lock);
+}
+#endif
+
+bool HotReloadApply(HotReload *reload, PongTuning *tuning)
+{
+    bool changed = false;
+
+    pthread_mutex_lock(&reload->lock);
+    for (int i = 0; i < reload->fileCount; i++) {
+        WatchedFile *file = &reload->files[i];
+        if (!file->pending) continue;
+
+        switch (file->kind)
+        {
+            case WATCH_TEXTURE:
+                UnloadTexture(*file->texture);
+                *file->texture = LoadTextureFromImage(file->image);
+                UnloadImage(file->image);
+                break;
+            case WATCH_SOUND:
+                UnloadSound(*file->sound);
+                *file->sound = LoadSoundFromWave(file->wave);
+                UnloadWave(file->wave);
+                break;
+            case WATCH_PAGE:
+                PagerInvalidate(file->pager, file->page);
+                break;
+            case WATCH_TUNING:
+                *tuning = file->tuning;
+                break;
+        }
+        file->pending = false;
+        changed = true;
+    }
+    pthread_mutex_unlock(&reload->lock);
+
+    return changed;
+}
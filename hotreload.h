@@ -0,0 +1,65 @@
+#ifndef HOTRELOAD_H
+#define HOTRELOAD_H
+
+#include <raylib.h>
+#include <pthread.h>
+#include "pager.h"
+#include "pongsim.h"
+
+// Live reloading of textures, sounds and the tuning file while the game runs.
+// A watcher thread waits on inotify for saved files and decodes them off the
+// main thread; HotReloadApply then swaps the GPU/audio resources in one go at
+// a frame boundary. Without inotify (non-Linux) nothing is watched and the
+// game runs as usual.
+
+#define HOTRELOAD_MAX_FILES 32
+#define HOTRELOAD_PATH_LENGTH 64
+
+typedef enum {
+    WATCH_TEXTURE,
+    WATCH_SOUND,
+    WATCH_PAGE,
+    WATCH_TUNING
+} WatchKind;
+
+typedef struct WatchedFile {
+    char path[HOTRELOAD_PATH_LENGTH]; // relative to the working directory
+    WatchKind kind;
+    Texture2D *texture; // resource swapped when the file changes
+    Sound *sound;
+    ImagePager *pager;  // WATCH_PAGE: the pager decodes the page itself
+    int page;
+    bool pending;       // decoded, waiting for HotReloadApply
+    Image image;
+    Wave wave;
+    PongTuning tuning;
+} WatchedFile;
+
+typedef struct HotReload {
+    WatchedFile files[HOTRELOAD_MAX_FILES];
+    int fileCount;
+    int watchFd;        // inotify descriptor, -1 when not watching
+    bool running;
+    pthread_t thread;
+    pthread_mutex_t lock; // guards the pending decodes
+} HotReload;
+
+// Reads "name value" lines (paddle_speed, ball_speed, score_delay) over the
+// values already in tuning. Returns false if the file can't be opened.
+bool LoadTuning(const char *path, PongTuning *tuning);
+
+void HotReloadInit(HotReload *reload);
+void HotReloadWatchTexture(HotReload *reload, const char *path, Texture2D *texture);
+void HotReloadWatchSound(HotReload *reload, const char *path, Sound *sound);
+// A page of an ImagePager; PagerInvalidate decides whether it gets loaded again
+void HotReloadWatchPage(HotReload *reload, const char *path, ImagePager *pager, int page);
+void HotReloadWatchTuning(HotReload *reload, const char *path);
+bool HotReloadStart(HotReload *reload); // starts the watcher thread, false if files can't be watched
+void HotReloadStop(HotReload *reload);
+
+// Call once per frame outside BeginDrawing/EndDrawing. Swaps in everything
+// decoded since the last call and returns true if anything changed; a changed
+// tuning file is written to *tuning.
+bool HotReloadApply(HotReload *reload, PongTuning *tuning);
+
+#endif
@@ -0,0 +1,62 @@
+#include "musicplayer.h"
+
+#include <time.h>
+
+static bool IsRunning(MusicPlayer *player)
+{
+    pthread_mutex_lock(&player->lock);
+    bool running = player->running;
+    pthread_mutex_unlock(&player->lock);
+    return running;
+}
+
+static void *MusicThread(void *arg)
+{
+    MusicPlayer *player = arg;
+    struct timespec pause = { 0, MUSIC_REFILL_MS * 1000000L };
+
+    // Only this thread touches the decoder from here on
+    while (IsRunning(player)) {
+        UpdateMusicStream(player->music);
+        nanosleep(&pause, NULL);
+    }
+
+    return NULL;
+}
+
+bool MusicPlayerStart(MusicPlayer *player, const char *path)
+{
+    player->running = false;
+
+    // Bigger halves give the refill thread more slack; sounds keep the default
+    SetAudioStreamBufferSizeDefault(MUSIC_BUFFER_FRAMES);
+    player->music = LoadMusicStream(path);
+    SetAudioStreamBufferSizeDefault(0);
+    if (player->music.frameCount == 0) return false;
+
+    pthread_mutex_init(&player->lock, NULL);
+    player->running = true;
+    PlayMusicStream(player->music);
+    if (pthread_create(&player->thread, NULL, MusicThread, player) != 0) {
+        player->running = false;
+        StopMusicStream(player->music);
+        UnloadMusicStream(player->music);
+        pthread_mutex_destroy(&player->lock);
+        return false;
+    }
+    return true;
+}
+
+void MusicPlayerStop(MusicPlayer *player)
+{
+    if (!player->running) return;
+
+    pthread_mutex_lock(&player->lock);
+    player->running = false;
+    pthread_mutex_unlock(&player->lock);
+    pthread_join(player->thread, NULL);
+
+    StopMusicStream(player->music);
+    UnloadMusicStream(player->music);
+    pthread_mutex_destroy(&player->lock);
+}
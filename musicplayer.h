@@ -0,0 +1,27 @@
+#ifndef MUSICPLAYER_H
+#define MUSICPLAYER_H
+
+#include <raylib.h>
+#include <pthread.h>
+
+// Streams a music file from its own thread. raylib's music stream is double
+// buffered: while one half plays, UpdateMusicStream decodes the next into the
+// other. Calling it from the frame loop means a slow frame can let the playing
+// half run out; here a dedicated thread keeps the idle half filled no matter
+// what the main thread is doing.
+
+#define MUSIC_BUFFER_FRAMES 8192 // per half, about 0.19 s at 44.1 kHz
+#define MUSIC_REFILL_MS 10       // how often the thread tops the stream up
+
+typedef struct MusicPlayer {
+    Music music;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    bool running;
+} MusicPlayer;
+
+// Loads and starts playing; false if the file couldn't be loaded
+bool MusicPlayerStart(MusicPlayer *player, const char *path);
+void MusicPlayerStop(MusicPlayer *player); // stops the thread and unloads the music
+
+#endif
@@ -0,0 +1,150 @@
+#include "pager.h"
+
+#include <string.h>
+
+static void *PagerWorker(void *arg)
+{
+    ImagePager *pager = arg;
+
+    pthread_mutex_lock(&pager->lock);
+    for (;;) {
+        while (pager->requestedPage < 0 && !pager->quit) pthread_cond_wait(&pager->wake, &pager->lock);
+        if (pager->quit) break;
+
+        int page = pager->requestedPage;
+        pager->requestedPage = -1;
+        pager->decodingPage = page;
+        unsigned int version = pager->versions[page];
+        pthread_mutex_unlock(&pager->lock);
+
+        Image image = LoadImage(pager->paths[page]);
+
+        pthread_mutex_lock(&pager->lock);
+        pager->decodingPage = -1;
+        // The file changed while it was being read, the old picture is no use
+        if (pager->versions[page] != version) {
+            UnloadImage(image);
+            continue;
+        }
+        // Only one decode is held at a time, a newer one replaces an unused older one
+        if (pager->decodedPage >= 0) UnloadImage(pager->decoded);
+        pager->decoded = image;
+        pager->decodedPage = page;
+    }
+    pthread_mutex_unlock(&pager->lock);
+
+    return NULL;
+}
+
+void PagerInit(ImagePager *pager, const char **paths, int count)
+{
+    memset(pager, 0, sizeof(*pager));
+    if (count > PAGER_MAX_PAGES) count = PAGER_MAX_PAGES;
+    for (int i = 0; i < count; i++) pager->paths[i] = paths[i];
+    pager->pageCount = count;
+    pager->direction = 1;
+    pager->requestedPage = 0; // ready before the instruction screen comes up
+    pager->decodingPage = -1;
+    pager->decodedPage = -1;
+
+    pthread_mutex_init(&pager->lock, NULL);
+    pthread_cond_init(&pager->wake, NULL);
+    pager->workerStarted = (pthread_create(&pager->thread, NULL, PagerWorker, pager) == 0);
+    if (!pager->workerStarted) pager->requestedPage = -1; // PagerShow loads every page itself
+}
+
+void PagerClose(ImagePager *pager)
+{
+    if (pager->workerStarted) {
+        pthread_mutex_lock(&pager->lock);
+        pager->quit = true;
+        pthread_cond_signal(&pager->wake);
+        pthread_mutex_unlock(&pager->lock);
+        pthread_join(pager->thread, NULL);
+    }
+
+    if (pager->decodedPage >= 0) UnloadImage(pager->decoded);
+    for (int i = 0; i < pager->pageCount; i++) {
+        if (pager->textures[i].id != 0) UnloadTexture(pager->textures[i]);
+    }
+
+    pthread_mutex_destroy(&pager->lock);
+    pthread_cond_destroy(&pager->wake);
+    pager->pageCount = 0; // later PagerInvalidate calls do nothing
+}
+
+// The page the player will most likely want after page
+static int Neighbour(const ImagePager *pager, int page)
+{
+    int neighbour = page + pager->direction;
+    if (neighbour < 0 || neighbour >= pager->pageCount) neighbour = page - pager->direction;
+    if (neighbour < 0 || neighbour >= pager->pageCount) neighbour = page;
+    return neighbour;
+}
+
+void PagerInvalidate(ImagePager *pager, int page)
+{
+    if (page < 0 || page >= pager->pageCount) return;
+
+    // The page on screen reloads in PagerShow, any other page only if it's next
+    if (pager->textures[page].id != 0) {
+        UnloadTexture(pager->textures[page]);
+        pager->textures[page] = (Texture2D){ 0 };
+    }
+
+    pthread_mutex_lock(&pager->lock);
+    pager->versions[page]++; // a decode in flight is of the old file
+    if (pager->decodedPage == page) {
+        UnloadImage(pager->decoded);
+        pager->decodedPage = -1;
+    }
+    if (pager->workerStarted && page != pager->currentPage && page == Neighbour(pager, pager->currentPage)) {
+        pager->requestedPage = page;
+        pthread_cond_signal(&pager->wake);
+    }
+    pthread_mutex_unlock(&pager->lock);
+}
+
+Texture2D PagerShow(ImagePager *pager, int page)
+{
+    if (page != pager->currentPage) pager->direction = (page > pager->currentPage) ? 1 : -1;
+    pager->currentPage = page;
+
+    int neighbour = Neighbour(pager, page);
+
+    pthread_mutex_lock(&pager->lock);
+
+    // Upload a finished decode if it's still wanted
+    if (pager->decodedPage >= 0) {
+        int decodedPage = pager->decodedPage;
+        if ((decodedPage == page || decodedPage == neighbour) && pager->textures[decodedPage].id == 0) {
+            pager->textures[decodedPage] = LoadTextureFromImage(pager->decoded);
+        }
+        UnloadImage(pager->decoded);
+        pager->decodedPage = -1;
+    }
+
+    // Queue the neighbour, unless it's resident or already on its way (without a
+    // worker nothing is queued and every page loads below when it's shown)
+    if (pager->workerStarted && pager->textures[neighbour].id == 0 && pager->decodingPage != neighbour) {
+        pager->requestedPage = neighbour;
+        pthread_cond_signal(&pager->wake);
+    } else if (pager->requestedPage != neighbour) {
+        pager->requestedPage = -1; // an older request nobody needs anymore
+    }
+
+    pthread_mutex_unlock(&pager->lock);
+
+    // The player paged faster than the worker could keep up
+    if (pager->textures[page].id == 0) pager->textures[page] = LoadTexture(pager->paths[page]);
+
+    // Evict everything else
+    for (int i = 0; i < pager->pageCount; i++) {
+        if (i != page && i != neighbour && pager->textures[i].id != 0) {
+            UnloadTexture(pager->textures[i]);
+            pager->textures[i] = (Texture2D){ 0 };
+        }
+    }
+
+    return pager->textures[page];
+}
@@ -0,0 +1,47 @@
+#ifndef PAGER_H
+#define PAGER_H
+
+#include <raylib.h>
+#include <pthread.h>
+
+// Shows a sequence of full-screen images (the instruction pages) while keeping
+// only the current page and the next one the player is likely to flip to on
+// the GPU. The neighbour is decoded on a worker thread; the main thread only
+// uploads it, so paging never waits on PNG decoding.
+
+#define PAGER_MAX_PAGES 8
+
+typedef struct ImagePager {
+    const char *paths[PAGER_MAX_PAGES];
+    int pageCount;
+    Texture2D textures[PAGER_MAX_PAGES]; // id 0 when the page isn't resident
+    int currentPage;
+    int direction;       // +1 or -1, the way the player last paged
+
+    pthread_t thread;
+    bool workerStarted;  // false if the thread couldn't start, pages then load on the main thread
+    pthread_mutex_t lock; // guards everything below
+    pthread_cond_t wake;
+    int requestedPage;   // page for the worker to decode, -1 for none
+    int decodingPage;    // page the worker is busy with, -1 for none
+    int decodedPage;     // page held in decoded, -1 for none
+    Image decoded;
+    unsigned int versions[PAGER_MAX_PAGES]; // bumped by PagerInvalidate, stale decodes are dropped
+    bool quit;
+} ImagePager;
+
+// Starts the worker and has it decode the first page straight away
+void PagerInit(ImagePager *pager, const char **paths, int count);
+void PagerClose(ImagePager *pager); // stops the worker and unloads every page, call once the pages are done with
+
+// The file behind page changed: drops the old texture and any decode of it.
+// Only the current page and its neighbour get loaded again, the rest wait
+// until they're shown.
+void PagerInvalidate(ImagePager *pager, int page);
+
+// Call once per frame outside BeginDrawing/EndDrawing. Makes page resident
+// (loading it right here only if the player outran the prefetch), evicts
+// everything but page and its neighbour, and queues the neighbour's decode.
+Texture2D PagerShow(ImagePager *pager, int page);
+
+#endif
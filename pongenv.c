@@ -0,0 +1,218 @@
+#include "pongenv.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+struct PongEnv {
+    int count;
+    PongSim *sims;            // one contiguous, cache-line aligned block, stepped in place
+    PongTuning tuning;        // shared by every sim, not copied into each one
+    float *observations;      // count * PONG_ENV_OBS_SIZE
+    float *rewards;           // count
+    unsigned char *dones;     // count
+    const unsigned char *actions; // set for the duration of PongEnvStep
+
+    // Worker pool; the calling thread takes the first slice itself
+    int threadCount;
+    pthread_t *threads;
+    pthread_mutex_t lock;
+    pthread_cond_t startCond;
+    pthread_cond_t doneCond;
+    unsigned int generation;  // bumped once per step to wake the workers
+    int pending;              // workers still busy with this step
+    bool quit;
+};
+
+typedef struct WorkerArgs {
+    PongEnv *env;
+    int index;
+} WorkerArgs;
+
+static void WriteObservation(float *obs, const PongSim *sim)
+{
+    obs[0] = (float)sim->paddle1X / SCREEN_WIDTH;
+    obs[1] = (float)sim->paddle1Y / SCREEN_HEIGHT;
+    obs[2] = (float)sim->paddle2X / SCREEN_WIDTH;
+    obs[3] = (float)sim->paddle2Y / SCREEN_HEIGHT;
+    obs[4] = ScalarToFloat(sim->ballX) / SCREEN_WIDTH;
+    obs[5] = ScalarToFloat(sim->ballY) / SCREEN_HEIGHT;
+    // Relative to the env's tuned speed, so it stays in [-1, 1] after PongEnvSetTuning
+    obs[6] = ScalarToFloat(sim->ballVelX) / sim->tuning->ballSpeed;
+    obs[7] = ScalarToFloat(sim->ballVelY) / sim->tuning->ballSpeed;
+}
+
+static void StepRange(PongEnv *env, int begin, int end)
+{
+    for (int i = begin; i < end; i++) {
+        PongSim *sim = &env->sims[i];
+        int events = PongSimStep(sim, env->actions[2 * i], env->actions[2 * i + 1]);
+
+        float reward = 0.0f;
+        if (events & PONG_EVENT_GOAL_PLAYER1) reward += 1.0f;
+        if (events & PONG_EVENT_GOAL_PLAYER2) reward -= 1.0f;
+        env->rewards[i] = reward;
+
+        env->dones[i] = (events & PONG_EVENT_GAME_END) != 0;
+        if (env->dones[i]) PongSimRestart(sim);
+
+        WriteObservation(&env->observations[i * PONG_ENV_OBS_SIZE], sim);
+    }
+}
+
+// Slice i of n, split so every thread gets a contiguous run of environments
+static void SliceBounds(int count, int slice, int slices, int *begin, int *end)
+{
+    *begin = (int)((long long)count * slice / slices);
+    *end = (int)((long long)count * (slice + 1) / slices);
+}
+
+static void *WorkerMain(void *arg)
+{
+    WorkerArgs *args = arg;
+    PongEnv *env = args->env;
+    int slice = args->index;
+    free(args);
+
+    unsigned int seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&env->lock);
+        while (env->generation == seen && !env->quit) pthread_cond_wait(&env->startCond, &env->lock);
+        if (env->quit) {
+            pthread_mutex_unlock(&env->lock);
+            return NULL;
+        }
+        seen = env->generation;
+        pthread_mutex_unlock(&env->lock);
+
+        int begin, end;
+        SliceBounds(env->count, slice, env->threadCount, &begin, &end);
+        StepRange(env, begin, end);
+
+        pthread_mutex_lock(&env->lock);
+        if (--env->pending == 0) pthread_cond_signal(&env->doneCond);
+        pthread_mutex_unlock(&env->lock);
+    }
+}
+
+PongEnv *PongEnvCreate(int count, int threadCount)
+{
+    if (count <= 0) return NULL;
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > count) threadCount = count;
+    if (threadCount > PONG_ENV_MAX_THREADS) threadCount = PONG_ENV_MAX_THREADS;
+
+    PongEnv *env = calloc(1, sizeof(PongEnv));
+    if (env == NULL) return NULL;
+    env->count = count;
+    if (posix_memalign((void **)&env->sims, 64, (size_t)count * sizeof(PongSim)) != 0) env->sims = NULL;
+    env->tuning = PongSimDefaultTuning();
+    env->observations = calloc((size_t)count * PONG_ENV_OBS_SIZE, sizeof(float));
+    env->rewards = calloc(count, sizeof(float));
+    env->dones = calloc(count, sizeof(unsigned char));
+    if (env->sims == NULL || env->observations == NULL || env->rewards == NULL || env->dones == NULL) {
+        PongEnvDestroy(env);
+        return NULL;
+    }
+
+    pthread_mutex_init(&env->lock, NULL);
+    pthread_cond_init(&env->startCond, NULL);
+    pthread_cond_init(&env->doneCond, NULL);
+    env->threadCount = 1;
+
+    if (threadCount > 1) {
+        env->threads = calloc(threadCount - 1, sizeof(pthread_t));
+        if (env->threads == NULL) {
+            PongEnvDestroy(env);
+            return NULL;
+        }
+        env->threadCount = threadCount;
+        for (int i = 1; i < threadCount; i++) {
+            WorkerArgs *args = malloc(sizeof(WorkerArgs));
+            if (args != NULL) {
+                args->env = env;
+                args->index = i;
+            }
+            if (args == NULL || pthread_create(&env->threads[i - 1], NULL, WorkerMain, args) != 0) {
+                free(args);
+                env->threadCount = i; // only the threads that started get joined
+                PongEnvDestroy(env);
+                return NULL;
+            }
+        }
+    }
+
+    PongEnvReset(env);
+    return env;
+}
+
+void PongEnvDestroy(PongEnv *env)
+{
+    if (env == NULL) return;
+
+    if (env->threads != NULL) {
+        pthread_mutex_lock(&env->lock);
+        env->quit = true;
+        pthread_cond_broadcast(&env->startCond);
+        pthread_mutex_unlock(&env->lock);
+        for (int i = 0; i < env->threadCount - 1; i++) pthread_join(env->threads[i], NULL);
+        free(env->threads);
+    }
+    if (env->threadCount > 0) {
+        pthread_mutex_destroy(&env->lock);
+        pthread_cond_destroy(&env->startCond);
+        pthread_cond_destroy(&env->doneCond);
+    }
+
+    free(env->sims);
+    free(env->observations);
+    free(env->rewards);
+    free(env->dones);
+    free(env);
+}
+
+void PongEnvReset(PongEnv *env)
+{
+    for (int i = 0; i < env->count; i++) {
+        PongSimInit(&env->sims[i], PADDLE_WIDTH, PADDLE_HEIGHT);
+        PongSimSetTuning(&env->sims[i], &env->tuning);
+        WriteObservation(&env->observations[i * PONG_ENV_OBS_SIZE], &env->sims[i]);
+        env->rewards[i] = 0.0f;
+        env->dones[i] = 0;
+    }
+}
+
+void PongEnvSetTuning(PongEnv *env, PongTuning tuning)
+{
+    env->tuning = tuning;
+    for (int i = 0; i < env->count; i++) PongSimSetTuning(&env->sims[i], &env->tuning);
+}
+
+void PongEnvStep(PongEnv *env, const unsigned char *actions)
+{
+    env->actions = actions;
+
+    if (env->threadCount == 1) {
+        StepRange(env, 0, env->count);
+        return;
+    }
+
+    pthread_mutex_lock(&env->lock);
+    env->pending = env->threadCount - 1;
+    env->generation++;
+    pthread_cond_broadcast(&env->startCond);
+    pthread_mutex_unlock(&env->lock);
+
+    int begin, end;
+    SliceBounds(env->count, 0, env->threadCount, &begin, &end);
+    StepRange(env, begin, end);
+
+    pthread_mutex_lock(&env->lock);
+    while (env->pending > 0) pthread_cond_wait(&env->doneCond, &env->lock);
+    pthread_mutex_unlock(&env->lock);
+}
+
+int PongEnvCount(const PongEnv *env) { return env->count; }
+const float *PongEnvObservations(const PongEnv *env) { return env->observations; }
+const float *PongEnvRewards(const PongEnv *env) { return env->rewards; }
+const unsigned char *PongEnvDones(const PongEnv *env) { return env->dones; }
+const PongSim *PongEnvSims(const PongEnv *env) { return env->sims; }
@@ -0,0 +1,52 @@
+#ifndef PONGENV_H
+#define PONGENV_H
+
+#include "pongsim.h"
+
+// Batched, headless Pongiverse environments for training paddle agents.
+// No window, GPU or audio: every environment is a PongSim stepped with the
+// same physics as the game, and results land in flat buffers that can be
+// handed to a training framework without copying.
+//
+//   PongEnv *env = PongEnvCreate(4096, 8);
+//   PongEnvReset(env);
+//   while (training) {
+//       FillActions(actions, PongEnvObservations(env)); // count * 2 input bytes
+//       PongEnvStep(env, actions);
+//       Learn(PongEnvRewards(env), PongEnvDones(env));
+//   }
+//   PongEnvDestroy(env);
+
+// Observation per environment, normalised to roughly [-1, 1]:
+// paddle1 x/y, paddle2 x/y, ball x/y, ball velocity x/y
+#define PONG_ENV_OBS_SIZE 8
+
+#define PONG_ENV_MAX_THREADS 64 // like LEAGUE_MAX_THREADS, more only adds wakeup overhead
+
+typedef struct PongEnv PongEnv;
+
+// threadCount <= 1 steps everything on the calling thread; it is capped at
+// count and PONG_ENV_MAX_THREADS. Returns NULL if the buffers or worker
+// threads can't be created.
+PongEnv *PongEnvCreate(int count, int threadCount);
+void PongEnvDestroy(PongEnv *env);
+
+// Starts a new match in every environment and writes the first observations
+void PongEnvReset(PongEnv *env);
+
+// Changes paddle/ball speeds for every environment at once; the env keeps one
+// copy of the tuning that all its sims point at
+void PongEnvSetTuning(PongEnv *env, PongTuning tuning);
+
+// Advances every environment one tick. actions holds two PONG_INPUT_* bytes
+// per environment (left paddle, right paddle). A finished match sets its done
+// flag and restarts, so the observation is already the next match's first.
+void PongEnvStep(PongEnv *env, const unsigned char *actions);
+
+int PongEnvCount(const PongEnv *env);
+const float *PongEnvObservations(const PongEnv *env); // count * PONG_ENV_OBS_SIZE
+const float *PongEnvRewards(const PongEnv *env);      // +1/-1 when the left/right player scores
+const unsigned char *PongEnvDones(const PongEnv *env);
+const PongSim *PongEnvSims(const PongEnv *env);       // raw state, e.g. for rendering
+
+#endif
@@ -1,18 +1,12 @@
 #include <raylib.h>
 #include <stdio.h>
 #include <unistd.h> // For sleep()
-
-// Screen and game object constants
-const int SCREEN_WIDTH = 1200;
-const int SCREEN_HEIGHT = 800;
-const int PADDLE_WIDTH = 15;
-const int PADDLE_HEIGHT = 150;
-const int BALL_SIZE = 25;
-
-// Paddle and ball speed
-const int PADDLE_SPEED = 5;
-const int BALL_SPEED = 600;
-const float SCORE_DELAY = 2.0f; // 2-second delay after scoring
+#include "pongsim.h" // Screen/game constants and the paddle, ball & score simulation
+#include "hotreload.h" // Picks up edited textures, sounds and tuning.cfg while running
+#include "pager.h" // Instruction pages, only the shown one and its neighbour are loaded
+#include "musicplayer.h" // Home screen music refilled from its own thread
+#include "arena.h" // Per-frame scratch memory, so the match loop never mallocs
+#include "allocguard.h" // -DPONGIVERSE_ALLOC_GUARD aborts on any malloc in the match loop
 
 
 int main(void) 
@@ -27,30 +21,26 @@ int main(void)
     // Initialize the game window
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Pongiverse");
     InitAudioDevice(); // Initialize audio system for sound effects
-    Texture2D currentBackground;
-    Texture2D currentPaddle;
-    Texture2D currentBall;
-    Sound currentCollisionSound;
+    // Point at the chosen mode's resources, so reloaded files show up right away
+    Texture2D *currentBackground;
+    Texture2D *currentPaddle;
+    Texture2D *currentBall;
+    Sound *currentCollisionSound;
     
     // Load PNG textures for HomeScreen and instructions
     Texture2D homeScreenTexture = LoadTexture("homescreen.png");
-    // Load all the instruction images
-    Texture2D instructionsTexture1 = LoadTexture("instructions1.png");
-    Texture2D instructionsTexture2 = LoadTexture("instructions2.png");
-    Texture2D instructionsTexture3 = LoadTexture("instructions3.png");
-    Texture2D instructionsTexture4 = LoadTexture("instructions4.png");
-    Texture2D instructionsTexture5 = LoadTexture("instructions5.png");
-  
-
-    // Store all textures in an array for easy access
-    Texture2D instructionsTextures[5] = { instructionsTexture1, instructionsTexture2, instructionsTexture3, instructionsTexture4, instructionsTexture5 };
+    // The instruction images are paged in as they're shown, the first one
+    // decodes in the background while the home screen is up
+    const char *instructionPaths[5] = { "instructions1.png", "instructions2.png", "instructions3.png", "instructions4.png", "instructions5.png" };
+    ImagePager instructionsPager;
+    PagerInit(&instructionsPager, instructionPaths, 5);
 
     // Initialize the current instruction image index
     int currentInstructionIndex = 0;
     
     // Load background music for home screen
-    Music homeScreenMusic = LoadMusicStream("homescreen_music.ogg");
-    PlayMusicStream(homeScreenMusic); // Play music when the home screen is displayed
+    MusicPlayer homeScreenMusic;
+    MusicPlayerStart(&homeScreenMusic, "homescreen_music.ogg"); // Play music when the home screen is displayed
     
     // Load PNG textures for Tennis paddles, ball, background, & sounds
     Texture2D tennisPaddle = LoadTexture("Tennispaddle.png");
@@ -77,19 +67,41 @@ int main(void)
     Font scoreFont = LoadFont("cartoon.ttf"); // Load custom font file
     
     Sound goalSound = LoadSound("goal_sound.ogg"); //Sound when goal is scored
+
+    // Paddle/ball speeds and the score delay can be changed in tuning.cfg
+    PongTuning tuning = PongSimDefaultTuning();
+    LoadTuning("tuning.cfg", &tuning);
+
+    // Watch every asset and the tuning file, edits apply without a restart
+    HotReload hotReload;
+    HotReloadInit(&hotReload);
+    HotReloadWatchTexture(&hotReload, "homescreen.png", &homeScreenTexture);
+    HotReloadWatchPage(&hotReload, "instructions1.png", &instructionsPager, 0);
+    HotReloadWatchPage(&hotReload, "instructions2.png", &instructionsPager, 1);
+    HotReloadWatchPage(&hotReload, "instructions3.png", &instructionsPager, 2);
+    HotReloadWatchPage(&hotReload, "instructions4.png", &instructionsPager, 3);
+    HotReloadWatchPage(&hotReload, "instructions5.png", &instructionsPager, 4);
+    HotReloadWatchTexture(&hotReload, "Tennispaddle.png", &tennisPaddle);
+    HotReloadWatchTexture(&hotReload, "ballsmall.png", &tennisBall);
+    HotReloadWatchTexture(&hotReload, "background.png", &tennisBackground);
+    HotReloadWatchSound(&hotReload, "collision.ogg", &tennisCollisionSound);
+    HotReloadWatchTexture(&hotReload, "table_tennis_background.png", &tableTennisBackground);
+    HotReloadWatchTexture(&hotReload, "table_tennis_paddle.png", &tableTennisPaddle);
+    HotReloadWatchTexture(&hotReload, "table_tennis_ball.png", &tableTennisBall);
+    HotReloadWatchSound(&hotReload, "table_tennis_collision.ogg", &tableTennisCollisionSound);
+    HotReloadWatchTexture(&hotReload, "air_hockey_background.png", &airHockeyBackground);
+    HotReloadWatchTexture(&hotReload, "air_hockey_paddle.png", &airHockeyPaddle);
+    HotReloadWatchTexture(&hotReload, "air_hockey_ball.png", &airHockeyBall);
+    HotReloadWatchSound(&hotReload, "air_hockey_collision.ogg", &airHockeyCollisionSound);
+    HotReloadWatchSound(&hotReload, "gameend.ogg", &gameEndSound);
+    HotReloadWatchSound(&hotReload, "goal_sound.ogg", &goalSound);
+    HotReloadWatchTuning(&hotReload, "tuning.cfg");
+    HotReloadStart(&hotReload);
     
-    // Initialize paddle and ball positions
-    int paddle1X = 0; // Left paddle position X
-    int paddle1Y = (SCREEN_HEIGHT - currentPaddle.height) / 2; // Center paddle vertically
-    int paddle2X = SCREEN_WIDTH - currentPaddle.width-90; // Right paddle position X
-    int paddle2Y = (SCREEN_HEIGHT - currentPaddle.height) / 2;
-
-    // Ball position (centered) and initial velocity
-    Vector2 ballPosition = {(SCREEN_WIDTH / 2) - (BALL_SIZE / 2), (SCREEN_HEIGHT / 2) - (BALL_SIZE / 2)};
-    Vector2 ballVelocity = {BALL_SPEED, BALL_SPEED};
-
-    int score1 = 0;  // Left player score
-    int score2 = 0;  // Right player score
+    // Paddles, ball and scores live in the simulation, set up once the mode is picked
+    PongSim sim;
+    float tickAccumulator = 0.0f; // Frame time not yet consumed by fixed ticks
+
     char player1Name[50] = ""; // Player 1 name input
     char player2Name[50] = ""; // Player 2 name input
     int nameMaxLength = 50; // Maximum length of the player names
@@ -98,10 +110,6 @@ int main(void)
 
     SetTargetFPS(120); // Set frame rate
 
-    // Variables for scoring timing
-    float scoreTimer = 0.0f; // Delay after scoring
-    bool ballActive = true; // Flag to determine if ball is in play
-    bool gameEnded = false; // Flag to check if the game has ended
     bool instructionsScreen = false; 
     bool homeScreen = true;
     
@@ -118,7 +126,7 @@ int main(void)
 
     while (homeScreen && !WindowShouldClose()) 
     {
-        UpdateMusicStream(homeScreenMusic); // Update music playback
+        HotReloadApply(&hotReload, &tuning);
         BeginDrawing();
         ClearBackground(RAYWHITE);
         
@@ -149,12 +157,13 @@ int main(void)
     // Display the instruction screen
     while (instructionsScreen && !WindowShouldClose()) 
     {
-        UpdateMusicStream(homeScreenMusic); 
+        HotReloadApply(&hotReload, &tuning);
+        Texture2D instructionsTexture = PagerShow(&instructionsPager, currentInstructionIndex);
         BeginDrawing();
         ClearBackground(RAYWHITE);
 
         // Draw the current instruction image
-        DrawTexture(instructionsTextures[currentInstructionIndex], 0, 0, WHITE); 
+        DrawTexture(instructionsTexture, 0, 0, WHITE); 
 
         EndDrawing();
 
@@ -168,10 +177,44 @@ int main(void)
 
         // Proceed to the game once ENTER is pressed
         if (IsKeyPressed(KEY_ENTER)) {
-            StopMusicStream(homeScreenMusic);
+            MusicPlayerStop(&homeScreenMusic);
             instructionsScreen = false; // Proceed to the game
         }
     }
+    // The instruction pages aren't shown again, free them before the match
+    PagerClose(&instructionsPager);
+
+    // Pick the textures and sound for the chosen mode
+    switch (currentMode) 
+    {
+        case MODE_TENNIS:
+            currentBackground = &tennisBackground;
+            currentPaddle = &tennisPaddle;
+            currentBall = &tennisBall;
+            currentCollisionSound = &tennisCollisionSound;
+            break;
+        case MODE_TABLE_TENNIS:
+            currentBackground = &tableTennisBackground;
+            currentPaddle = &tableTennisPaddle;
+            currentBall = &tableTennisBall;
+            currentCollisionSound = &tableTennisCollisionSound;
+            break;
+        case MODE_AIR_HOCKEY:
+            currentBackground = &airHockeyBackground;
+            currentPaddle = &airHockeyPaddle;
+            currentBall = &airHockeyBall;
+            currentCollisionSound = &airHockeyCollisionSound;
+            break;
+        }
+
+    PongSimInit(&sim, currentPaddle->width, currentPaddle->height);
+    PongSimSetTuning(&sim, &tuning);
+
+    // Scratch memory for one frame (HUD text), reset at the start of every frame
+    Arena frameArena;
+    ArenaInit(&frameArena, FRAME_ARENA_SIZE);
+    bool firstMatchFrameDone = false; // the allocation guard starts after it
+
 bool isPaused = false;
     // Main game loop
     while (!WindowShouldClose()) 
@@ -198,148 +241,75 @@ bool isPaused = false;
         EndDrawing();
         continue;
     }
-    switch (currentMode) 
-    {
-        case MODE_TENNIS:
-            currentBackground = tennisBackground;
-            currentPaddle = tennisPaddle;
-            currentBall = tennisBall;
-            currentCollisionSound = tennisCollisionSound;
-            break;
-        case MODE_TABLE_TENNIS:
-            currentBackground = tableTennisBackground;
-            currentPaddle = tableTennisPaddle;
-            currentBall = tableTennisBall;
-            currentCollisionSound = tableTennisCollisionSound;
-            break;
-        case MODE_AIR_HOCKEY:
-            currentBackground = airHockeyBackground;
-            currentPaddle = airHockeyPaddle;
-            currentBall = airHockeyBall;
-            currentCollisionSound = airHockeyCollisionSound;
-            break;
-        }        
+        // Swap in edited files between frames
+        if (HotReloadApply(&hotReload, &tuning)) {
+            PongSimSetTuning(&sim, &tuning);
+            sim.paddleWidth = currentPaddle->width; // a redrawn paddle may be a different size
+            sim.paddleHeight = currentPaddle->height;
+        }
+
+        // No heap allocations from here until the frame is presented
+        ArenaReset(&frameArena);
+        if (firstMatchFrameDone) AllocGuardArm();
+
         // Left Paddle Movement (W, S for up/down; A, D for left/right)
-        if (IsKeyDown(KEY_W) && paddle1Y > 0) paddle1Y -= PADDLE_SPEED; // Move up
-        if (IsKeyDown(KEY_S) && paddle1Y < SCREEN_HEIGHT - currentPaddle.height) paddle1Y += PADDLE_SPEED; // Move down
-        if (IsKeyDown(KEY_A) && paddle1X > 0) paddle1X -= PADDLE_SPEED; // Move left
-        if (IsKeyDown(KEY_D) && paddle1X < (SCREEN_WIDTH / 2) - currentPaddle.width) paddle1X += PADDLE_SPEED; // Move right
+        unsigned char input1 = 0;
+        if (IsKeyDown(KEY_W)) input1 |= PONG_INPUT_UP;
+        if (IsKeyDown(KEY_S)) input1 |= PONG_INPUT_DOWN;
+        if (IsKeyDown(KEY_A)) input1 |= PONG_INPUT_LEFT;
+        if (IsKeyDown(KEY_D)) input1 |= PONG_INPUT_RIGHT;
 
         // Right Paddle Movement (Arrow keys for up/down; Left/Right arrows for left/right)
-        if (IsKeyDown(KEY_UP) && paddle2Y > 0) paddle2Y -= PADDLE_SPEED; // Move up
-        if (IsKeyDown(KEY_DOWN) && paddle2Y < SCREEN_HEIGHT - currentPaddle.height) paddle2Y += PADDLE_SPEED; // Move down
-        if (IsKeyDown(KEY_LEFT) && paddle2X > (SCREEN_WIDTH / 2)) paddle2X -= PADDLE_SPEED; // Move left
-        if (IsKeyDown(KEY_RIGHT) && paddle2X < SCREEN_WIDTH - currentPaddle.width) paddle2X += PADDLE_SPEED; // Move right
-
-        // Ball Movement Logic
-        if (ballActive && !gameEnded) {
-            ballPosition.x += ballVelocity.x * GetFrameTime();
-            ballPosition.y += ballVelocity.y * GetFrameTime();
-
-            if (ballPosition.y <= 0 || ballPosition.y + BALL_SIZE >= SCREEN_HEIGHT) {
-                ballVelocity.y *= -1;  // Reverse Y direction
-            }
-
-            // Check for collision with Left Paddle
-            if (ballPosition.x >= paddle1X &&
-                ballPosition.x <= paddle1X + currentPaddle.width &&
-                ballPosition.y + BALL_SIZE >= paddle1Y && ballPosition.y <= paddle1Y + currentPaddle.height) {
-                ballVelocity.x *= -1;  // Reverse X direction
-                ballPosition.x = paddle1X + currentPaddle.width;  // Adjust to avoid overlap
-                
-                PlaySound(currentCollisionSound);  // Play collision sound
-            }
-
-            // Check for collision with Right Paddle
-            if (ballPosition.x + BALL_SIZE >= paddle2X &&
-                ballPosition.x  <= paddle2X + currentPaddle.width  &&
-                ballPosition.y + BALL_SIZE >= paddle2Y && ballPosition.y <= paddle2Y + currentPaddle.height) {
-                ballVelocity.x *= -1;  // Reverse X direction
-                ballPosition.x = paddle2X - BALL_SIZE; // Adjust position to avoid overlap
-                
-                PlaySound(currentCollisionSound);  // Play collision sound
-            }
-
-            // Scoring Logic
-            if (ballPosition.x < 0) {
-                score2++;  // Right player scores
-                ballActive = false;
-                PlaySound(goalSound);  // Play goal sound
-                scoreTimer = SCORE_DELAY;
-                ballPosition = (Vector2){(SCREEN_WIDTH / 2) - (BALL_SIZE / 2), (SCREEN_HEIGHT / 2) - (BALL_SIZE / 2)};
-                
-            }
-            if (ballPosition.x > SCREEN_WIDTH) {
-                score1++;  // Left player scores
-                ballActive = false;
-                PlaySound(goalSound);  // Play goal sound
-                scoreTimer = SCORE_DELAY;
-                ballPosition = (Vector2){(SCREEN_WIDTH / 2) - (BALL_SIZE / 2), (SCREEN_HEIGHT / 2) - (BALL_SIZE / 2)};
-            }
-        } 
-        else if (!gameEnded) //runs if the game has not ended
-        { //delays the ball's reactivation to give players a brief pause after a score.
-            scoreTimer -= GetFrameTime(); //timer for pause
-            if (scoreTimer <= 0) //resumes the game
-            {
-                ballActive = true;
-                ballVelocity.x = (score1 > score2) ? BALL_SPEED : -BALL_SPEED; //determines where should ball go first after point is scored
-            }
+        unsigned char input2 = 0;
+        if (IsKeyDown(KEY_UP)) input2 |= PONG_INPUT_UP;
+        if (IsKeyDown(KEY_DOWN)) input2 |= PONG_INPUT_DOWN;
+        if (IsKeyDown(KEY_LEFT)) input2 |= PONG_INPUT_LEFT;
+        if (IsKeyDown(KEY_RIGHT)) input2 |= PONG_INPUT_RIGHT;
+
+        // Run as many fixed ticks as this frame's time covers, so the match
+        // plays out the same no matter the frame rate
+        tickAccumulator += GetFrameTime();
+        if (tickAccumulator > 0.25f) tickAccumulator = 0.25f; // don't spiral after a long hitch
+        int events = 0;
+        while (tickAccumulator >= PONG_TICK_TIME) {
+            events |= PongSimStep(&sim, input1, input2);
+            tickAccumulator -= PONG_TICK_TIME;
         }
 
-        // Check for game end condition
-    if (score1 ==  7 || score2 == 7) 
-    {
-        if (!gameEnded) 
-        {  // Ensure sound is played only once
-            gameEnded = true;
-            ballActive = false;
-            PlaySound(gameEndSound); // Play game end sound
-        }
-        if (gameEnded) {
-   
-
-   
+        if (events & PONG_EVENT_PADDLE_HIT) PlaySound(*currentCollisionSound);  // Play collision sound
+        if (events & (PONG_EVENT_GOAL_PLAYER1 | PONG_EVENT_GOAL_PLAYER2)) PlaySound(goalSound);  // Play goal sound
+        if (events & PONG_EVENT_GAME_END) PlaySound(gameEndSound); // Play game end sound
 
-    // Handle user input
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+        // Handle game over buttons
+    if (sim.gameEnded && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
         Vector2 mousePos = GetMousePosition();
 
         if (CheckCollisionPointRec(mousePos, restartButton)) {
             // Restart the game
-            score1 = 0;
-            score2 = 0;
-            ballPosition = (Vector2){(SCREEN_WIDTH / 2) - (BALL_SIZE / 2), (SCREEN_HEIGHT / 2) - (BALL_SIZE / 2)};
-            ballVelocity = (Vector2){BALL_SPEED, BALL_SPEED};
-            ballActive = true;
-            gameEnded = false;
+            PongSimRestart(&sim);
+            tickAccumulator = 0.0f;
         } else if (CheckCollisionPointRec(mousePos, quitButton)) {
             // Quit the game
             break;
         }
-    }
-}
-
     }
         // Render game elements
         BeginDrawing();
         ClearBackground(RAYWHITE);
         
-        DrawTextureEx(currentBackground, (Vector2){0, 0}, 0.0f, 
-        (float)SCREEN_WIDTH / currentBackground.width, WHITE);
+        DrawTextureEx(*currentBackground, (Vector2){0, 0}, 0.0f, 
+        (float)SCREEN_WIDTH / currentBackground->width, WHITE);
         
-        DrawTexture(currentPaddle, paddle1X, paddle1Y, WHITE);
-        DrawTexture(currentPaddle, paddle2X, paddle2Y, WHITE);
-        if (ballActive) 
+        DrawTexture(*currentPaddle, sim.paddle1X, sim.paddle1Y, WHITE);
+        DrawTexture(*currentPaddle, sim.paddle2X, sim.paddle2Y, WHITE);
+        if (sim.ballActive) 
         {
-            DrawTexture(currentBall, ballPosition.x, ballPosition.y, WHITE);
+            DrawTexture(*currentBall, ScalarToInt(sim.ballX), ScalarToInt(sim.ballY), WHITE);
         }
         
         // Draw scores
-        char scoreText1[10];
-        char scoreText2[10];
-        sprintf(scoreText1, "%d", score1);
-        sprintf(scoreText2, "%d", score2);
+        const char *scoreText1 = ArenaPrintf(&frameArena, "%d", sim.score1);
+        const char *scoreText2 = ArenaPrintf(&frameArena, "%d", sim.score2);
         DrawTextEx(scoreFont, scoreText1, (Vector2){SCREEN_WIDTH / 4, 15}, 80, 2, WHITE);
         DrawTextEx(scoreFont, scoreText2, (Vector2){3 * SCREEN_WIDTH / 4, 15}, 80, 2, WHITE); 
         //Syntax (fromwhere_load,whattoprint, vector2 called (x,y),font height, sapce b/w letters, color)
@@ -348,15 +318,15 @@ bool isPaused = false;
         DrawTextEx(scoreFont, "Player 2", (Vector2){SCREEN_WIDTH - 220, 50}, 60, 2, WHITE);
 
         // Display win message
-        if (score1 == 7) 
+        if (sim.score1 == WINNING_SCORE) 
         {
             DrawTextEx(scoreFont, "Player 1 Wins!", (Vector2){360, 250}, 80, 2, WHITE);
         } 
-        else if (score2 == 7) 
+        else if (sim.score2 == WINNING_SCORE) 
         {
             DrawTextEx(scoreFont, "Player 2 Wins!", (Vector2){350, 250}, 80, 2, WHITE);
         }
-        if(gameEnded){
+        if(sim.gameEnded){
         // Render the rectangle bar
     DrawRectangle(barX, barY, barWidth, barHeight, DARKBLUE); // Background
     DrawTextEx(scoreFont, "Game Over", (Vector2){barX + 100, barY + 15}, 50, 1, WHITE);  // Title text
@@ -369,11 +339,18 @@ bool isPaused = false;
     
         }
 
+        AllocGuardDisarm(); // the graphics driver may allocate while presenting
         EndDrawing();
+        firstMatchFrameDone = true;
         
     }
+    AllocGuardDisarm(); // Quit leaves the loop mid-frame
+
+    TraceLog(LOG_INFO, "PONGIVERSE: Frame arena high-water mark %zu of %zu bytes", frameArena.highWater, frameArena.capacity);
+    ArenaFree(&frameArena);
 
     // Unload resources
+    HotReloadStop(&hotReload);
     UnloadTexture(tennisPaddle);
     UnloadTexture(tennisBall);
     UnloadTexture(tennisBackground);
@@ -383,7 +360,7 @@ bool isPaused = false;
     UnloadTexture(airHockeyBackground);
     UnloadTexture(airHockeyPaddle);
     UnloadTexture(airHockeyBall);
-    UnloadTexture(instructionsTexture1);
+    MusicPlayerStop(&homeScreenMusic); // in case the window closed on the home screen
     UnloadTexture(homeScreenTexture);
     UnloadFont(scoreFont);
     UnloadSound(tennisCollisionSound);
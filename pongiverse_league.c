@@ -0,0 +1,102 @@
+#include <raylib.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // For sysconf()
+#include "pongleague.h"
+
+// League viewer: plays a tournament between the AI paddles in a roster file on
+// every core and shows the table live. Closing the window stops the league;
+// starting it again with the same roster resumes from league_checkpoint.txt.
+//
+// Usage: pongiverse_league [roster.txt] [roundrobin|bracket] [threads]
+
+static League league; // too big for the stack
+
+static void *RunLeague(void *arg)
+{
+    int threadCount = *(int *)arg;
+    LeagueRun(&league, threadCount);
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    const char *rosterPath = (argc > 1) ? argv[1] : "league_roster.txt";
+    LeagueFormat format = (argc > 2 && strcmp(argv[2], "bracket") == 0) ? LEAGUE_BRACKET : LEAGUE_ROUND_ROBIN;
+    int threadCount = (argc > 3) ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    PongAIConfig roster[LEAGUE_MAX_ENTRIES];
+    int rosterCount = LeagueLoadRoster(rosterPath, roster, LEAGUE_MAX_ENTRIES);
+    if (!LeagueInit(&league, format, roster, rosterCount, "league_checkpoint.txt")) {
+        printf("Need 2 to %d paddles in %s\n", LEAGUE_MAX_ENTRIES, rosterPath);
+        return 1;
+    }
+
+    // Matches run on their own threads so the window never waits on them
+    pthread_t leagueThread;
+    if (pthread_create(&leagueThread, NULL, RunLeague, &threadCount) != 0) {
+        printf("Can't start the league thread\n");
+        LeagueClose(&league);
+        return 1;
+    }
+
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Pongiverse League");
+    SetTargetFPS(30);
+
+    LeagueEntry standings[LEAGUE_MAX_ENTRIES];
+    while (!WindowShouldClose())
+    {
+        int played = 0;
+        int scheduled = 0;
+        int count = LeagueStandings(&league, standings, &played, &scheduled);
+
+        BeginDrawing();
+        ClearBackground(DARKBLUE);
+
+        DrawText(format == LEAGUE_BRACKET ? "Bracket" : "Round Robin", 40, 20, 40, WHITE);
+        DrawText(TextFormat("%d / %d matches", played, scheduled), 40, 70, 20, LIGHTGRAY);
+
+        // Progress bar
+        DrawRectangle(40, 100, SCREEN_WIDTH - 80, 10, DARKGRAY);
+        if (scheduled > 0) DrawRectangle(40, 100, (SCREEN_WIDTH - 80) * played / scheduled, 10, GOLD);
+
+        // Table, best rating first
+        const int columnX[] = { 40, 90, 500, 640, 720, 800 };
+        const char *headings[] = { "#", "Paddle", "Rating", "W", "L", "D" };
+        for (int c = 0; c < 6; c++) DrawText(headings[c], columnX[c], 130, 20, GOLD);
+
+        int rowHeight = 22;
+        int maxRows = (SCREEN_HEIGHT - 170) / rowHeight;
+        for (int i = 0; i < count && i < maxRows; i++) {
+            const LeagueEntry *entry = &standings[i];
+            int y = 160 + i * rowHeight;
+            DrawText(TextFormat("%d", i + 1), columnX[0], y, 20, WHITE);
+            DrawText(entry->ai.name, columnX[1], y, 20, WHITE);
+            DrawText(TextFormat("%.0f", entry->rating), columnX[2], y, 20, WHITE);
+            DrawText(TextFormat("%d", entry->wins), columnX[3], y, 20, WHITE);
+            DrawText(TextFormat("%d", entry->losses), columnX[4], y, 20, WHITE);
+            DrawText(TextFormat("%d", entry->draws), columnX[5], y, 20, WHITE);
+        }
+
+        pthread_mutex_lock(&league.lock);
+        bool finished = league.finished;
+        int champion = league.champion;
+        pthread_mutex_unlock(&league.lock);
+        if (champion >= 0) {
+            DrawText(TextFormat("Champion: %s", league.entries[champion].ai.name), 600, 20, 40, GOLD);
+        } else if (finished) {
+            DrawText("League finished", 600, 20, 40, GOLD);
+        }
+
+        EndDrawing();
+    }
+
+    LeagueStop(&league);
+    pthread_join(leagueThread, NULL);
+    LeagueClose(&league);
+
+    CloseWindow();
+    return 0;
+}
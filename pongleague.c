@@ -0,0 +1,479 @@
+#include "pongleague.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHASE_DISTANCE 150 // how far a chasing paddle leaves its home position
+
+static unsigned int NextRandom(unsigned int *state)
+{
+    // xorshift32, so every match replays the same on any machine
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+unsigned char PongAIInput(const PongAIConfig *ai, const PongSim *sim, int side, unsigned int *rng)
+{
+    if (ai->reaction < 100 && (int)(NextRandom(rng) % 100) >= ai->reaction) return 0;
+
+    int paddleX = (side == 1) ? sim->paddle1X : sim->paddle2X;
+    int paddleY = (side == 1) ? sim->paddle1Y : sim->paddle2Y;
+    unsigned char input = 0;
+
+    // Track the ball vertically
+    int ballCenterY = ScalarToInt(sim->ballY) + BALL_SIZE / 2;
+    int aimY = paddleY + sim->paddleHeight / 2 + ai->aimOffset;
+    if (ballCenterY < aimY - ai->deadzone) input |= PONG_INPUT_UP;
+    else if (ballCenterY > aimY + ai->deadzone) input |= PONG_INPUT_DOWN;
+
+    // Step forward while the ball comes in, drop back once it's going away
+    if (ai->chase) {
+        bool incoming = (side == 1) ? sim->ballVelX < 0 : sim->ballVelX > 0;
+        int homeX = (side == 1) ? 0 : SCREEN_WIDTH - sim->paddleWidth - 90;
+        int targetX = homeX;
+        if (incoming && sim->ballActive) targetX += (side == 1) ? CHASE_DISTANCE : -CHASE_DISTANCE;
+        if (paddleX < targetX) input |= PONG_INPUT_RIGHT;
+        else if (paddleX > targetX) input |= PONG_INPUT_LEFT;
+    }
+
+    return input;
+}
+
+int LeagueLoadRoster(const char *path, PongAIConfig *roster, int maxCount)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) return 0;
+
+    int count = 0;
+    char line[256];
+    while (count < maxCount && fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') continue; // comments and blank lines
+
+        PongAIConfig ai = { 0 };
+        int chase = 0;
+        if (sscanf(line, "%31s %d %d %d %d", ai.name, &ai.deadzone, &ai.aimOffset, &ai.reaction, &chase) == 5) {
+            ai.chase = chase != 0;
+            roster[count++] = ai;
+        }
+    }
+
+    fclose(file);
+    return count;
+}
+
+//------------------------------------------------------------------------------------
+// Scheduling and ratings (league lock held)
+//------------------------------------------------------------------------------------
+static void AddMatch(League *league, int round, int player1, int player2)
+{
+    LeagueMatch *match = &league->matches[league->matchCount++];
+    memset(match, 0, sizeof(*match));
+    match->round = round;
+    match->player1 = player1;
+    match->player2 = player2;
+    if (player2 < 0) {
+        // Bye: player1 goes through without playing
+        match->claimed = true;
+        match->played = true;
+        league->playedCount++;
+    }
+}
+
+static void ScheduleRoundRobin(League *league)
+{
+    // Circle method: player 0 stays put while everyone else rotates. An odd
+    // roster gets a dummy player and whoever meets it sits the round out.
+    int n = league->entryCount;
+    int slots = (n % 2 == 0) ? n : n + 1;
+    int order[LEAGUE_MAX_ENTRIES + 1];
+
+    for (int round = 0; round < slots - 1; round++) {
+        order[0] = 0;
+        for (int k = 1; k < slots; k++) order[k] = 1 + (k - 1 + round) % (slots - 1);
+
+        for (int i = 0; i < slots / 2; i++) {
+            int a = order[i];
+            int b = order[slots - 1 - i];
+            if (a >= n || b >= n) continue;
+            // The two sides aren't symmetric, so alternate who starts on the left
+            if ((round + i) % 2) AddMatch(league, round, b, a);
+            else AddMatch(league, round, a, b);
+        }
+    }
+    league->roundCount = slots - 1;
+}
+
+static void ScheduleFirstBracketRound(League *league)
+{
+    int n = league->entryCount;
+    int size = 1;
+    while (size < n) size *= 2;
+
+    // Standard seeding order so the top seeds can only meet in the late rounds
+    int order[LEAGUE_MAX_ENTRIES];
+    int length = 1;
+    order[0] = 0;
+    while (length < size) {
+        for (int i = length - 1; i >= 0; i--) {
+            order[2 * i] = order[i];
+            order[2 * i + 1] = 2 * length - 1 - order[i];
+        }
+        length *= 2;
+    }
+
+    for (int i = 0; i < size; i += 2) {
+        AddMatch(league, 0, order[i], (order[i + 1] < n) ? order[i + 1] : -1);
+    }
+    league->roundCount = 1;
+}
+
+static int MatchWinner(const LeagueMatch *match)
+{
+    if (match->player2 < 0) return match->player1;
+    if (match->score1 > match->score2) return match->player1;
+    if (match->score2 > match->score1) return match->player2;
+    // A called match goes to the higher seed
+    return (match->player1 < match->player2) ? match->player1 : match->player2;
+}
+
+static void ScheduleNextBracketRound(League *league)
+{
+    int round = league->roundCount - 1;
+    int winners[LEAGUE_MAX_ENTRIES];
+    int winnerCount = 0;
+
+    for (int i = 0; i < league->matchCount; i++) {
+        if (league->matches[i].round == round) winners[winnerCount++] = MatchWinner(&league->matches[i]);
+    }
+
+    if (winnerCount == 1) {
+        league->champion = winners[0];
+        league->finished = true;
+        return;
+    }
+
+    for (int i = 0; i + 1 < winnerCount; i += 2) AddMatch(league, round + 1, winners[i], winners[i + 1]);
+    league->roundCount++;
+}
+
+static void ApplyResult(League *league, const LeagueMatch *match)
+{
+    if (match->player2 < 0) return;
+
+    LeagueEntry *a = &league->entries[match->player1];
+    LeagueEntry *b = &league->entries[match->player2];
+
+    double scoreA = 0.5;
+    if (match->score1 > match->score2) {
+        scoreA = 1.0;
+        a->wins++;
+        b->losses++;
+    } else if (match->score2 > match->score1) {
+        scoreA = 0.0;
+        a->losses++;
+        b->wins++;
+    } else {
+        a->draws++;
+        b->draws++;
+    }
+
+    double expectedA = 1.0 / (1.0 + pow(10.0, (b->rating - a->rating) / 400.0));
+    double change = LEAGUE_ELO_K * (scoreA - expectedA);
+    a->rating += change;
+    b->rating -= change;
+}
+
+static bool RoundComplete(const League *league, int round)
+{
+    for (int i = 0; i < league->matchCount; i++) {
+        if (league->matches[i].round == round && !league->matches[i].played) return false;
+    }
+    return true;
+}
+
+// Folds finished rounds into the ratings in schedule order, so results don't
+// depend on which worker finished first. Returns true if any round was applied.
+static bool AdvanceRounds(League *league)
+{
+    bool advanced = false;
+
+    while (!league->finished && league->roundsApplied < league->roundCount &&
+           RoundComplete(league, league->roundsApplied)) {
+        for (int i = 0; i < league->matchCount; i++) {
+            if (league->matches[i].round == league->roundsApplied) ApplyResult(league, &league->matches[i]);
+        }
+        league->roundsApplied++;
+        advanced = true;
+
+        if (league->roundsApplied == league->roundCount) {
+            if (league->format == LEAGUE_BRACKET) ScheduleNextBracketRound(league);
+            else league->finished = true;
+        }
+    }
+
+    return advanced;
+}
+
+//------------------------------------------------------------------------------------
+// Checkpoints
+//------------------------------------------------------------------------------------
+static const char *FormatName(LeagueFormat format)
+{
+    return (format == LEAGUE_BRACKET) ? "bracket" : "roundrobin";
+}
+
+typedef struct CheckpointResult {
+    int match;
+    int score1, score2;
+} CheckpointResult;
+
+// Only reads what LeagueInit set up (path, format, names), so it runs without
+// league->lock; results is a snapshot taken under it
+static void WriteCheckpoint(League *league, const CheckpointResult *results, int resultCount, unsigned int serial)
+{
+    pthread_mutex_lock(&league->checkpointLock);
+    // A worker that snapshotted later already got here first, don't go back in time
+    if (serial <= league->checkpointWritten) {
+        pthread_mutex_unlock(&league->checkpointLock);
+        return;
+    }
+
+    // Write a temporary file and rename it over the old one, so a crash
+    // mid-write never leaves a torn checkpoint behind
+    char tempPath[sizeof(league->checkpointPath) + 4];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", league->checkpointPath);
+    FILE *file = fopen(tempPath, "w");
+    if (file != NULL) {
+        fprintf(file, "pongiverse-league 1 %s %d\n", FormatName(league->format), league->entryCount);
+        for (int i = 0; i < league->entryCount; i++) fprintf(file, "%s\n", league->entries[i].ai.name);
+        for (int i = 0; i < resultCount; i++) fprintf(file, "%d %d %d\n", results[i].match, results[i].score1, results[i].score2);
+
+        fclose(file);
+        rename(tempPath, league->checkpointPath);
+        league->checkpointWritten = serial;
+    }
+    pthread_mutex_unlock(&league->checkpointLock);
+}
+
+// Called with league->lock held. Copies the played results, then drops the
+// lock for the file write so other workers keep claiming matches meanwhile.
+static void SaveCheckpoint(League *league, CheckpointResult *results)
+{
+    if (league->checkpointPath[0] == '\0') return;
+
+    int resultCount = 0;
+    for (int i = 0; i < league->matchCount; i++) {
+        const LeagueMatch *match = &league->matches[i];
+        if (!match->played || match->player2 < 0) continue;
+        results[resultCount].match = i;
+        results[resultCount].score1 = match->score1;
+        results[resultCount].score2 = match->score2;
+        resultCount++;
+    }
+    unsigned int serial = ++league->checkpointSerial;
+
+    pthread_mutex_unlock(&league->lock);
+    WriteCheckpoint(league, results, resultCount, serial);
+    pthread_mutex_lock(&league->lock);
+}
+
+static void LoadCheckpoint(League *league)
+{
+    FILE *file = fopen(league->checkpointPath, "r");
+    if (file == NULL) return;
+
+    char format[32];
+    int version = 0, entryCount = 0;
+    if (fscanf(file, "pongiverse-league %d %31s %d", &version, format, &entryCount) != 3 ||
+        version != 1 || strcmp(format, FormatName(league->format)) != 0 || entryCount != league->entryCount) {
+        fclose(file);
+        return;
+    }
+    for (int i = 0; i < entryCount; i++) {
+        char name[LEAGUE_NAME_LENGTH];
+        if (fscanf(file, "%31s", name) != 1 || strcmp(name, league->entries[i].ai.name) != 0) {
+            fclose(file); // a different roster, start over
+            return;
+        }
+    }
+
+    static CheckpointResult results[LEAGUE_MAX_MATCHES];
+    int resultCount = 0;
+    while (resultCount < LEAGUE_MAX_MATCHES &&
+           fscanf(file, "%d %d %d", &results[resultCount].match, &results[resultCount].score1, &results[resultCount].score2) == 3) {
+        resultCount++;
+    }
+    fclose(file);
+
+    // Bracket rounds only exist once the round before them is applied, so keep
+    // filling in results until nothing new gets scheduled
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (int i = 0; i < resultCount; i++) {
+            int index = results[i].match;
+            if (index < 0 || index >= league->matchCount) continue;
+            LeagueMatch *match = &league->matches[index];
+            if (match->played) continue;
+            match->score1 = results[i].score1;
+            match->score2 = results[i].score2;
+            match->claimed = true;
+            match->played = true;
+            league->playedCount++;
+            progress = true;
+        }
+        if (AdvanceRounds(league)) progress = true;
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Running
+//------------------------------------------------------------------------------------
+bool LeagueInit(League *league, LeagueFormat format, const PongAIConfig *roster, int count, const char *checkpointPath)
+{
+    if (count < 2 || count > LEAGUE_MAX_ENTRIES) return false;
+
+    memset(league, 0, sizeof(*league));
+    league->format = format;
+    league->entryCount = count;
+    league->champion = -1;
+    for (int i = 0; i < count; i++) {
+        league->entries[i].ai = roster[i];
+        league->entries[i].rating = LEAGUE_START_RATING;
+    }
+    if (checkpointPath != NULL) snprintf(league->checkpointPath, sizeof(league->checkpointPath), "%s", checkpointPath);
+
+    if (format == LEAGUE_BRACKET) ScheduleFirstBracketRound(league);
+    else ScheduleRoundRobin(league);
+    AdvanceRounds(league); // a round of nothing but byes is already over
+
+    if (league->checkpointPath[0] != '\0') LoadCheckpoint(league);
+
+    pthread_mutex_init(&league->lock, NULL);
+    pthread_cond_init(&league->changed, NULL);
+    pthread_mutex_init(&league->checkpointLock, NULL);
+    return true;
+}
+
+void LeagueClose(League *league)
+{
+    pthread_mutex_destroy(&league->lock);
+    pthread_cond_destroy(&league->changed);
+    pthread_mutex_destroy(&league->checkpointLock);
+}
+
+static void PlayMatch(const League *league, LeagueMatch *match, int index)
+{
+    const PongAIConfig *ai1 = &league->entries[match->player1].ai;
+    const PongAIConfig *ai2 = &league->entries[match->player2].ai;
+
+    // Seed from the schedule, not the thread, so a match always plays the same
+    unsigned int rng1 = 2654435761u * (unsigned int)(index + 1);
+    unsigned int rng2 = rng1 ^ 0x9e3779b9u;
+
+    PongSim sim;
+    PongSimInit(&sim, PADDLE_WIDTH, PADDLE_HEIGHT);
+    for (int tick = 0; tick < LEAGUE_MATCH_TICK_LIMIT && !sim.gameEnded; tick++) {
+        PongSimStep(&sim, PongAIInput(ai1, &sim, 1, &rng1), PongAIInput(ai2, &sim, 2, &rng2));
+    }
+
+    match->score1 = sim.score1;
+    match->score2 = sim.score2;
+}
+
+static void *LeagueWorker(void *arg)
+{
+    League *league = arg;
+    CheckpointResult results[LEAGUE_MAX_MATCHES];
+
+    pthread_mutex_lock(&league->lock);
+    while (!league->finished && !league->stopRequested) {
+        int index = -1;
+        for (int i = 0; i < league->matchCount; i++) {
+            if (!league->matches[i].claimed) {
+                index = i;
+                break;
+            }
+        }
+
+        if (index < 0) {
+            // The next bracket round waits on matches other workers are playing
+            pthread_cond_wait(&league->changed, &league->lock);
+            continue;
+        }
+
+        LeagueMatch *match = &league->matches[index];
+        match->claimed = true;
+        LeagueMatch result = *match;
+        pthread_mutex_unlock(&league->lock);
+
+        PlayMatch(league, &result, index);
+
+        pthread_mutex_lock(&league->lock);
+        match->score1 = result.score1;
+        match->score2 = result.score2;
+        match->played = true;
+        league->playedCount++;
+        bool advanced = AdvanceRounds(league);
+        pthread_cond_broadcast(&league->changed);
+        if (advanced) SaveCheckpoint(league, results);
+    }
+    pthread_mutex_unlock(&league->lock);
+
+    return NULL;
+}
+
+void LeagueRun(League *league, int threadCount)
+{
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > LEAGUE_MAX_THREADS) threadCount = LEAGUE_MAX_THREADS;
+
+    pthread_t threads[LEAGUE_MAX_THREADS];
+    int started = 0;
+    for (int i = 0; i < threadCount - 1; i++) {
+        if (pthread_create(&threads[started], NULL, LeagueWorker, league) == 0) started++;
+    }
+
+    LeagueWorker(league);
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+    // Keep results of a round that was cut short by LeagueStop
+    CheckpointResult results[LEAGUE_MAX_MATCHES];
+    pthread_mutex_lock(&league->lock);
+    SaveCheckpoint(league, results);
+    pthread_mutex_unlock(&league->lock);
+}
+
+void LeagueStop(League *league)
+{
+    pthread_mutex_lock(&league->lock);
+    league->stopRequested = true;
+    pthread_cond_broadcast(&league->changed);
+    pthread_mutex_unlock(&league->lock);
+}
+
+static int CompareRating(const void *a, const void *b)
+{
+    double ra = ((const LeagueEntry *)a)->rating;
+    double rb = ((const LeagueEntry *)b)->rating;
+    return (ra < rb) - (ra > rb);
+}
+
+int LeagueStandings(League *league, LeagueEntry *out, int *playedCount, int *matchCount)
+{
+    pthread_mutex_lock(&league->lock);
+    int count = league->entryCount;
+    memcpy(out, league->entries, count * sizeof(LeagueEntry));
+    if (playedCount != NULL) *playedCount = league->playedCount;
+    if (matchCount != NULL) *matchCount = league->matchCount;
+    pthread_mutex_unlock(&league->lock);
+
+    qsort(out, count, sizeof(LeagueEntry), CompareRating);
+    return count;
+}
@@ -0,0 +1,91 @@
+#ifndef PONGLEAGUE_H
+#define PONGLEAGUE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include "pongsim.h"
+
+// Tournaments between AI paddle configurations. Matches run headless (first to
+// WINNING_SCORE) on worker threads, Elo ratings update in schedule order so a
+// league gives the same table however many threads played it, and progress is
+// checkpointed after every finished round so long leagues can resume.
+
+#define LEAGUE_MAX_ENTRIES 64
+#define LEAGUE_MAX_MATCHES (LEAGUE_MAX_ENTRIES * LEAGUE_MAX_ENTRIES / 2)
+#define LEAGUE_MAX_THREADS 64
+#define LEAGUE_NAME_LENGTH 32
+#define LEAGUE_START_RATING 1500.0
+#define LEAGUE_ELO_K 32.0
+#define LEAGUE_MATCH_TICK_LIMIT (PONG_TICK_RATE * 600) // 10 minutes of play, then the match is called
+
+// How an AI paddle plays. Roster files hold one per line:
+// name deadzone aimOffset reaction chase
+typedef struct PongAIConfig {
+    char name[LEAGUE_NAME_LENGTH];
+    int deadzone;   // pixels the ball may drift from the aim point before the paddle moves
+    int aimOffset;  // where on the paddle it tries to meet the ball, from the centre
+    int reaction;   // percent of ticks the paddle reacts on
+    bool chase;     // steps forward to meet an incoming ball
+} PongAIConfig;
+
+// Inputs for the left (side 1) or right (side 2) paddle this tick
+unsigned char PongAIInput(const PongAIConfig *ai, const PongSim *sim, int side, unsigned int *rng);
+
+typedef enum {
+    LEAGUE_ROUND_ROBIN,
+    LEAGUE_BRACKET  // single elimination, roster order is the seeding
+} LeagueFormat;
+
+typedef struct LeagueEntry {
+    PongAIConfig ai;
+    double rating;
+    int wins, losses, draws;
+} LeagueEntry;
+
+typedef struct LeagueMatch {
+    int round;
+    int player1, player2; // player2 is -1 for a bracket bye
+    int score1, score2;
+    bool claimed;         // a worker is playing (or has played) it
+    bool played;
+} LeagueMatch;
+
+typedef struct League {
+    LeagueFormat format;
+    int entryCount;
+    LeagueEntry entries[LEAGUE_MAX_ENTRIES];
+    int matchCount;
+    LeagueMatch matches[LEAGUE_MAX_MATCHES];
+    int roundCount;       // rounds scheduled so far (bracket rounds appear as the previous one ends)
+    int roundsApplied;    // rounds whose results are in the ratings
+    int playedCount;
+    int champion;         // -1 until a bracket is won
+    bool finished;
+    bool stopRequested;
+    char checkpointPath[256];
+
+    pthread_mutex_t lock; // guards everything above once LeagueRun has started
+    pthread_cond_t changed;
+    unsigned int checkpointSerial;  // result snapshots taken, guarded by lock
+
+    pthread_mutex_t checkpointLock; // held while the checkpoint file is written, keeps writes in order
+    unsigned int checkpointWritten; // serial of the snapshot on disk, guarded by checkpointLock
+} League;
+
+// Reads a roster file, returns the number of configurations read
+int LeagueLoadRoster(const char *path, PongAIConfig *roster, int maxCount);
+
+// Schedules the league. If checkpointPath names a checkpoint of the same roster
+// and format, its results are replayed so the league carries on where it stopped.
+bool LeagueInit(League *league, LeagueFormat format, const PongAIConfig *roster, int count, const char *checkpointPath);
+void LeagueClose(League *league);
+
+// Plays every remaining match on threadCount threads (the caller included)
+// and returns when the league is finished or LeagueStop was called.
+void LeagueRun(League *league, int threadCount);
+void LeagueStop(League *league); // matches in flight finish, nothing new starts
+
+// Thread-safe copy of the table sorted by rating, returns the entry count
+int LeagueStandings(League *league, LeagueEntry *out, int *playedCount, int *matchCount);
+
+#endif
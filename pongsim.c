@@ -0,0 +1,171 @@
+#include "pongsim.h"
+
+static void ResetBall(PongSim *sim)
+{
+    sim->ballX = ScalarFromInt((SCREEN_WIDTH / 2) - (BALL_SIZE / 2));
+    sim->ballY = ScalarFromInt((SCREEN_HEIGHT / 2) - (BALL_SIZE / 2));
+}
+
+static const PongTuning defaultTuning = { PADDLE_SPEED, BALL_SPEED, SCORE_DELAY_TICKS };
+
+PongTuning PongSimDefaultTuning(void)
+{
+    return defaultTuning;
+}
+
+void PongSimInit(PongSim *sim, int paddleWidth, int paddleHeight)
+{
+    sim->tuning = &defaultTuning;
+    sim->paddleWidth = paddleWidth;
+    sim->paddleHeight = paddleHeight;
+    sim->paddle1X = 0; // Left paddle position X
+    sim->paddle1Y = (SCREEN_HEIGHT - paddleHeight) / 2; // Center paddle vertically
+    sim->paddle2X = SCREEN_WIDTH - paddleWidth - 90; // Right paddle position X
+    sim->paddle2Y = (SCREEN_HEIGHT - paddleHeight) / 2;
+    PongSimRestart(sim);
+}
+
+void PongSimRestart(PongSim *sim)
+{
+    ResetBall(sim);
+    sim->ballVelX = ScalarFromInt(sim->tuning->ballSpeed);
+    sim->ballVelY = ScalarFromInt(sim->tuning->ballSpeed);
+    sim->score1 = 0;
+    sim->score2 = 0;
+    sim->scoreTicks = 0;
+    sim->ballActive = true;
+    sim->gameEnded = false;
+}
+
+void PongSimSetTuning(PongSim *sim, const PongTuning *tuning)
+{
+    sim->tuning = tuning;
+
+    // Keep the ball's direction but move it at the new speed
+    sim->ballVelX = ScalarFromInt((sim->ballVelX < 0) ? -tuning->ballSpeed : tuning->ballSpeed);
+    sim->ballVelY = ScalarFromInt((sim->ballVelY < 0) ? -tuning->ballSpeed : tuning->ballSpeed);
+}
+
+int PongSimStep(PongSim *sim, unsigned char input1, unsigned char input2)
+{
+    int events = 0;
+    int paddleSpeed = sim->tuning->paddleSpeed;
+
+    // Left Paddle Movement (W, S for up/down; A, D for left/right)
+    if ((input1 & PONG_INPUT_UP) && sim->paddle1Y > 0) sim->paddle1Y -= paddleSpeed;
+    if ((input1 & PONG_INPUT_DOWN) && sim->paddle1Y < SCREEN_HEIGHT - sim->paddleHeight) sim->paddle1Y += paddleSpeed;
+    if ((input1 & PONG_INPUT_LEFT) && sim->paddle1X > 0) sim->paddle1X -= paddleSpeed;
+    if ((input1 & PONG_INPUT_RIGHT) && sim->paddle1X < (SCREEN_WIDTH / 2) - sim->paddleWidth) sim->paddle1X += paddleSpeed;
+
+    // Right Paddle Movement (Arrow keys for up/down; Left/Right arrows for left/right)
+    if ((input2 & PONG_INPUT_UP) && sim->paddle2Y > 0) sim->paddle2Y -= paddleSpeed;
+    if ((input2 & PONG_INPUT_DOWN) && sim->paddle2Y < SCREEN_HEIGHT - sim->paddleHeight) sim->paddle2Y += paddleSpeed;
+    if ((input2 & PONG_INPUT_LEFT) && sim->paddle2X > (SCREEN_WIDTH / 2)) sim->paddle2X -= paddleSpeed;
+    if ((input2 & PONG_INPUT_RIGHT) && sim->paddle2X < SCREEN_WIDTH - sim->paddleWidth) sim->paddle2X += paddleSpeed;
+
+    // Ball Movement Logic
+    if (sim->ballActive && !sim->gameEnded) {
+        // Velocity is per second, so one tick moves it by velocity / tick rate
+        sim->ballX += sim->ballVelX / PONG_TICK_RATE;
+        sim->ballY += sim->ballVelY / PONG_TICK_RATE;
+
+        if (sim->ballY <= 0 || sim->ballY + ScalarFromInt(BALL_SIZE) >= ScalarFromInt(SCREEN_HEIGHT)) {
+            sim->ballVelY = -sim->ballVelY;  // Reverse Y direction
+        }
+
+        // Check for collision with Left Paddle
+        if (sim->ballX >= ScalarFromInt(sim->paddle1X) &&
+            sim->ballX <= ScalarFromInt(sim->paddle1X + sim->paddleWidth) &&
+            sim->ballY + ScalarFromInt(BALL_SIZE) >= ScalarFromInt(sim->paddle1Y) &&
+            sim->ballY <= ScalarFromInt(sim->paddle1Y + sim->paddleHeight)) {
+            sim->ballVelX = -sim->ballVelX;  // Reverse X direction
+            sim->ballX = ScalarFromInt(sim->paddle1X + sim->paddleWidth);  // Adjust to avoid overlap
+            events |= PONG_EVENT_PADDLE_HIT;
+        }
+
+        // Check for collision with Right Paddle
+        if (sim->ballX + ScalarFromInt(BALL_SIZE) >= ScalarFromInt(sim->paddle2X) &&
+            sim->ballX <= ScalarFromInt(sim->paddle2X + sim->paddleWidth) &&
+            sim->ballY + ScalarFromInt(BALL_SIZE) >= ScalarFromInt(sim->paddle2Y) &&
+            sim->ballY <= ScalarFromInt(sim->paddle2Y + sim->paddleHeight)) {
+            sim->ballVelX = -sim->ballVelX;  // Reverse X direction
+            sim->ballX = ScalarFromInt(sim->paddle2X - BALL_SIZE); // Adjust position to avoid overlap
+            events |= PONG_EVENT_PADDLE_HIT;
+        }
+
+        // Scoring Logic
+        if (sim->ballX < 0) {
+            sim->score2++;  // Right player scores
+            sim->ballActive = false;
+            sim->scoreTicks = sim->tuning->scoreDelayTicks;
+            ResetBall(sim);
+            events |= PONG_EVENT_GOAL_PLAYER2;
+        }
+        if (sim->ballX > ScalarFromInt(SCREEN_WIDTH)) {
+            sim->score1++;  // Left player scores
+            sim->ballActive = false;
+            sim->scoreTicks = sim->tuning->scoreDelayTicks;
+            ResetBall(sim);
+            events |= PONG_EVENT_GOAL_PLAYER1;
+        }
+    }
+    else if (!sim->gameEnded) // delays the ball's reactivation after a score
+    {
+        sim->scoreTicks--;
+        if (sim->scoreTicks <= 0) // resumes the game
+        {
+            sim->ballActive = true;
+            // the leading player serves
+            sim->ballVelX = ScalarFromInt((sim->score1 > sim->score2) ? sim->tuning->ballSpeed : -sim->tuning->ballSpeed);
+        }
+    }
+
+    // Check for game end condition
+    if ((sim->score1 == WINNING_SCORE || sim->score2 == WINNING_SCORE) && !sim->gameEnded) {
+        sim->gameEnded = true;
+        sim->ballActive = false;
+        events |= PONG_EVENT_GAME_END;
+    }
+
+    return events;
+}
+
+static uint64_t HashInt(uint64_t hash, int64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        hash ^= (uint64_t)(value >> (i * 8)) & 0xff;
+        hash *= 1099511628211ULL; // FNV prime
+    }
+    return hash;
+}
+
+uint64_t PongSimHash(const PongSim *sim)
+{
+    uint64_t hash = 14695981039346656037ULL; // FNV offset basis
+    hash = HashInt(hash, sim->tuning->paddleSpeed);
+    hash = HashInt(hash, sim->tuning->ballSpeed);
+    hash = HashInt(hash, sim->tuning->scoreDelayTicks);
+    hash = HashInt(hash, sim->paddle1X);
+    hash = HashInt(hash, sim->paddle1Y);
+    hash = HashInt(hash, sim->paddle2X);
+    hash = HashInt(hash, sim->paddle2Y);
+#ifdef PONGIVERSE_FIXED_POINT
+    hash = HashInt(hash, sim->ballX);
+    hash = HashInt(hash, sim->ballY);
+    hash = HashInt(hash, sim->ballVelX);
+    hash = HashInt(hash, sim->ballVelY);
+#else
+    // Hash the exact bit patterns so float drift between builds shows up
+    union { float f; int32_t i; } bits;
+    bits.f = sim->ballX;    hash = HashInt(hash, bits.i);
+    bits.f = sim->ballY;    hash = HashInt(hash, bits.i);
+    bits.f = sim->ballVelX; hash = HashInt(hash, bits.i);
+    bits.f = sim->ballVelY; hash = HashInt(hash, bits.i);
+#endif
+    hash = HashInt(hash, sim->score1);
+    hash = HashInt(hash, sim->score2);
+    hash = HashInt(hash, sim->scoreTicks);
+    hash = HashInt(hash, sim->ballActive);
+    hash = HashInt(hash, sim->gameEnded);
+    return hash;
+}
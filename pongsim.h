@@ -0,0 +1,92 @@
+#ifndef PONGSIM_H
+#define PONGSIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Headless Pongiverse simulation: paddles, ball and scoring without raylib.
+// The game advances it in fixed ticks so every build computes the same match.
+
+// Screen and game object constants
+#define SCREEN_WIDTH 1200
+#define SCREEN_HEIGHT 800
+#define PADDLE_WIDTH 15
+#define PADDLE_HEIGHT 150
+#define BALL_SIZE 25
+
+// Paddle and ball speed defaults, a PongTuning can change them while running
+#define PADDLE_SPEED 5     // pixels per tick
+#define BALL_SPEED 600     // pixels per second
+#define SCORE_DELAY_TICKS (2 * PONG_TICK_RATE) // 2-second delay after scoring
+#define WINNING_SCORE 7
+
+// Simulation rate, matches the game's SetTargetFPS(120)
+#define PONG_TICK_RATE 120
+#define PONG_TICK_TIME (1.0f / PONG_TICK_RATE)
+
+// Limits for a PongTuning. A faster ball moves more than a paddle's width in
+// one tick and can pass straight through it (this also keeps Q16.16 velocities
+// far from overflow); a faster paddle overshoots the screen edges.
+#define PONG_MAX_BALL_SPEED (PADDLE_WIDTH * PONG_TICK_RATE) // 1800 pixels per second
+#define PONG_MAX_PADDLE_SPEED 30                            // pixels per tick
+#define PONG_MAX_SCORE_DELAY_TICKS (60 * PONG_TICK_RATE)    // a minute
+
+// Build with -DPONGIVERSE_FIXED_POINT to run the ball in Q16.16 integer math.
+// Fixed point gives bit-identical results across compilers and flags
+// (-O0/-O3/-ffast-math, x87/SSE, FMA contraction) which replays rely on.
+#ifdef PONGIVERSE_FIXED_POINT
+typedef int32_t Scalar; // Q16.16
+#define SCALAR_ONE 65536
+#define ScalarFromInt(i) ((Scalar)(i) * SCALAR_ONE)
+#define ScalarToInt(s) ((int)((s) >> 16))
+#define ScalarToFloat(s) ((float)(s) / SCALAR_ONE)
+#else
+typedef float Scalar;
+#define SCALAR_ONE 1.0f
+#define ScalarFromInt(i) ((Scalar)(i))
+#define ScalarToInt(s) ((int)(s))
+#define ScalarToFloat(s) ((float)(s))
+#endif
+
+// Paddle input flags, one byte per player per tick
+#define PONG_INPUT_UP 0x01
+#define PONG_INPUT_DOWN 0x02
+#define PONG_INPUT_LEFT 0x04
+#define PONG_INPUT_RIGHT 0x08
+
+// Events returned by PongSimStep so the caller can play sounds
+#define PONG_EVENT_PADDLE_HIT 0x01
+#define PONG_EVENT_GOAL_PLAYER1 0x02 // left player scored
+#define PONG_EVENT_GOAL_PLAYER2 0x04 // right player scored
+#define PONG_EVENT_GAME_END 0x08
+
+// Integers only, so tuning never brings float math into the fixed-point build
+typedef struct PongTuning {
+    int paddleSpeed;     // pixels per tick, at most PONG_MAX_PADDLE_SPEED
+    int ballSpeed;       // pixels per second, at most PONG_MAX_BALL_SPEED
+    int scoreDelayTicks; // ticks before the serve after a goal, at most PONG_MAX_SCORE_DELAY_TICKS
+} PongTuning;
+
+// 64 bytes on 64-bit builds, one cache line per sim in a PongEnv
+typedef struct PongSim {
+    const PongTuning *tuning; // shared, e.g. one per PongEnv; must outlive the sim
+    int paddleWidth;  // taken from the mode's paddle texture
+    int paddleHeight;
+    int paddle1X, paddle1Y; // Left paddle
+    int paddle2X, paddle2Y; // Right paddle
+    Scalar ballX, ballY;
+    Scalar ballVelX, ballVelY; // pixels per second
+    int score1, score2;
+    int scoreTicks;   // ticks left in the pause after a goal
+    bool ballActive;  // Flag to determine if ball is in play
+    bool gameEnded;   // Flag to check if the game has ended
+} PongSim;
+
+void PongSimInit(PongSim *sim, int paddleWidth, int paddleHeight);
+void PongSimRestart(PongSim *sim); // New match, paddles stay where they are
+void PongSimSetTuning(PongSim *sim, const PongTuning *tuning); // takes effect on the next tick, ball in flight included
+PongTuning PongSimDefaultTuning(void);
+int PongSimStep(PongSim *sim, unsigned char input1, unsigned char input2); // returns PONG_EVENT_* flags
+uint64_t PongSimHash(const PongSim *sim); // FNV-1a of the state, for replay/determinism checks
+
+#endif
@@ -0,0 +1,17 @@
+# Runs every determinism build given in BUILDS (a ;-separated list of
+# executables) and fails unless they all print the same hash.
+# cmake -DBUILDS="a;b;c" -P CompareHashes.cmake
+
+set(expected "")
+foreach(build IN LISTS BUILDS)
+    execute_process(COMMAND ${build} OUTPUT_VARIABLE output RESULT_VARIABLE result OUTPUT_STRIP_TRAILING_WHITESPACE)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${build} failed: ${result}")
+    endif()
+    message(STATUS "${build}: ${output}")
+    if(expected STREQUAL "")
+        set(expected "${output}")
+    elseif(NOT output STREQUAL expected)
+        message(FATAL_ERROR "${build} printed ${output}, expected ${expected}")
+    endif()
+endforeach()
@@ -0,0 +1,29 @@
+#include <stdio.h>
+#include "pongsim.h"
+
+// Plays a long seeded match and prints the final state hash. CMake builds this
+// at several optimisation levels and CompareHashes.cmake checks that every
+// build printed the same line.
+
+#define DETERMINISM_TICKS 1000000
+
+int main(void)
+{
+    PongSim sim;
+    PongSimInit(&sim, PADDLE_WIDTH, PADDLE_HEIGHT);
+    unsigned int rng = 1;
+    int games = 0;
+
+    for (int i = 0; i < DETERMINISM_TICKS; i++) {
+        rng = rng * 1103515245u + 12345u;
+        unsigned char input1 = (rng >> 16) & 0x0f;
+        unsigned char input2 = (rng >> 20) & 0x0f;
+        if (PongSimStep(&sim, input1, input2) & PONG_EVENT_GAME_END) {
+            PongSimRestart(&sim);
+            games++;
+        }
+    }
+
+    printf("%016llx %d games\n", (unsigned long long)PongSimHash(&sim), games);
+    return 0;
+}
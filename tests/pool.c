@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include "arena.h"
+
+// Pool bookkeeping: hands out every item exactly once, reuses released ones,
+// tracks the high-water mark and turns away pointers it doesn't own.
+
+#define POOL_CAPACITY 8
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+int main(void)
+{
+    Pool pool;
+    CHECK(PoolInit(&pool, 24, POOL_CAPACITY));
+    CHECK(pool.itemSize % ARENA_ALIGNMENT == 0);
+
+    // Acquire until the pool runs dry, every item distinct and aligned
+    void *items[POOL_CAPACITY];
+    for (int i = 0; i < POOL_CAPACITY; i++) {
+        items[i] = PoolAcquire(&pool);
+        CHECK(items[i] != NULL);
+        CHECK((size_t)items[i] % ARENA_ALIGNMENT == 0);
+        for (int j = 0; j < i; j++) CHECK(items[i] != items[j]);
+    }
+    CHECK(PoolAcquire(&pool) == NULL);
+    CHECK(PoolInUse(&pool) == POOL_CAPACITY);
+    CHECK(pool.highWater == POOL_CAPACITY);
+
+    // A released item comes back on the next acquire
+    CHECK(PoolRelease(&pool, items[3]));
+    CHECK(PoolInUse(&pool) == POOL_CAPACITY - 1);
+    CHECK(PoolAcquire(&pool) == items[3]);
+
+    // The high-water mark stays at the peak after items are released
+    for (int i = 0; i < POOL_CAPACITY; i++) CHECK(PoolRelease(&pool, items[i]));
+    CHECK(PoolInUse(&pool) == 0);
+    CHECK(pool.highWater == POOL_CAPACITY);
+
+    // Double releases, foreign and misaligned pointers leave the free list alone
+    CHECK(!PoolRelease(&pool, items[0]));
+    int notPooled;
+    CHECK(!PoolRelease(&pool, &notPooled));
+    CHECK(!PoolRelease(&pool, (unsigned char *)items[1] + 1));
+    CHECK(!PoolRelease(&pool, pool.items + pool.itemSize * POOL_CAPACITY));
+    CHECK(!PoolRelease(&pool, NULL));
+    CHECK(PoolInUse(&pool) == 0);
+
+    // Still exactly capacity distinct items afterwards
+    for (int i = 0; i < POOL_CAPACITY; i++) CHECK(PoolAcquire(&pool) != NULL);
+    CHECK(PoolAcquire(&pool) == NULL);
+
+    PoolFree(&pool);
+
+    if (failures > 0) printf("%d check(s) failed\n", failures);
+    return failures > 0;
+}